@@ -13,8 +13,7 @@
 
 // GUI Labels (Visible to user)
 const juce::String GAIN_IN_LABEL = "INPUT TRIM";
-const juce::String LOW_MID_XOVER_LABEL = "LOW-MID X-OVER";
-const juce::String MID_HIGH_XOVER_LABEL = "MID-HI X-OVER";
+const juce::String XOVER_LABEL_SUFFIX = " X-OVER"; // after the two bands it splits, e.g. "LOW-MID X-OVER"
 const juce::String GAIN_OUT_LABEL = "OUTPUT TRIM";
 
 const juce::String ATTACK_LABEL = "ATTACK";
@@ -26,10 +25,6 @@ const juce::String BYPASSED_LABEL = "X";
 const juce::String SOLO_LABEL = "S";
 const juce::String MUTE_LABEL = "M";
 
-const juce::String LOW_BUTTON_LABEL = "Low";
-const juce::String MID_BUTTON_LABEL = "Mid";
-const juce::String HIGH_BUTTON_LABEL = "High";
-
 //==============================================================================
 // Ranges
 const float THRESHOLD_MIN_VAL = -60.f;
@@ -41,6 +36,11 @@ const float ATTACK_RELEASE_MAX_VAL = 500.f;
 const float ATTACK_DEFAULT = 50.f;
 const float RELEASE_DEFAULT = 250.f;
 
+const float LOOKAHEAD_MIN_MS = 0.f;
+const float LOOKAHEAD_MAX_MS = 10.f;
+const float LOOKAHEAD_INTERVAL_MS = 0.1f;
+const float LOOKAHEAD_DEFAULT_MS = 0.f;
+
 const float DEFAULT_INTERVAL = 1.f;
 const float DEFAULT_SKEW_FACTOR = 1.f;
 
@@ -49,6 +49,35 @@ const float RATIO_DEFAULT = 3.f;
 
 const bool APVTS_BOOL_DEFAULT = false;
 
+// order matches SimpleMBCompAudioProcessor::CrossoverMode
+const juce::StringArray CROSSOVER_MODE_CHOICES{ "Linkwitz-Riley", "Complementary", "Linear Phase", "Spectral" };
+const int CROSSOVER_MODE_DEFAULT = 0;
+
+// order matches CrossoverSlope
+const juce::StringArray CROSSOVER_SLOPE_CHOICES{ "12 dB/Oct", "24 dB/Oct", "48 dB/Oct" };
+const int CROSSOVER_SLOPE_DEFAULT = 1;
+
+// order matches BandOversampler::Factor and BandOversampler::FilterType
+const juce::StringArray OVERSAMPLING_CHOICES{ "1x", "2x", "4x" };
+const int OVERSAMPLING_DEFAULT = 0;
+const int OVERSAMPLING_HIGH_BAND_DEFAULT = 1; // the high band is where the gain stage aliases first
+const juce::StringArray OVERSAMPLING_FILTER_CHOICES{ "Polyphase IIR", "Linear Phase FIR" };
+const int OVERSAMPLING_FILTER_DEFAULT = 0;
+
+// order matches ChannelLayout::Link, independent detectors are how every channel has always been compressed
+const juce::StringArray CHANNEL_LINK_CHOICES{ "Independent", "Stereo Pairs", "Groups", "All" };
+const int CHANNEL_LINK_DEFAULT = 0;
+
+// bands the spectral engine compresses, whatever NUM_BANDS is. Choices are built from the counts
+const auto SPECTRAL_BAND_COUNTS = std::vector<int>{ 16, 24, 32, 48, 64 };
+const int SPECTRAL_BANDS_DEFAULT = 2; // 32
+const int SPECTRAL_BANDS_MAX = 64;
+
+// How often each band evaluates its gain computer, order matches the control rates in CompressorBand.cpp.
+// Every sample is how the gain has always been computed
+const juce::StringArray CONTROL_RATE_CHOICES{ "Every Sample", "8 Samples Linear", "8 Samples Cubic", "16 Samples Linear", "16 Samples Cubic" };
+const int CONTROL_RATE_DEFAULT = 0;
+
 const float LOW_MID_MIN_FREQ = 20.f;
 const float LOW_MID_MAX_FREQ = 999.f;
 const float MID_HIGH_MIN_FREQ = 1000.f;
@@ -74,6 +103,40 @@ const double SLIDER_MAX_RANGE_DOUBLE = 1.0;
 
 const float ABSOLUTE_MINIMUM_GAIN = -48.f; // Scale only goes to -48dB
 
+//==============================================================================
+// DSP
+// The number of bands is fixed at compile time, builds with 2 to 5 bands are made by defining MBCOMP_NUM_BANDS.
+// SimpleMBComp.jucer has a Debug/Release configuration pair for each count
+#ifndef MBCOMP_NUM_BANDS
+ #define MBCOMP_NUM_BANDS 3
+#endif
+constexpr int NUM_BANDS = MBCOMP_NUM_BANDS;
+static_assert(NUM_BANDS >= 2 && NUM_BANDS <= 5, "MBCOMP_NUM_BANDS must be between 2 and 5");
+const int MAX_CHANNELS = 12; // 7.1.4, the widest layout supported
+
+const double MULTIRATE_MIN_SAMPLE_RATE = 44100.0; // the low band is never decimated below this
+const int MULTIRATE_TAPS_PER_PHASE = 16;
+const float MULTIRATE_KAISER_BETA = 8.f; // roughly 80 dB of stopband rejection
+const double BAND_FADE_SECONDS = 0.02; // mute/solo fade, also hides filters restarting after a solo
+const double BYPASS_FADE_SECONDS = 0.02; // global bypass crossfade
+const int SUB_BLOCK_SIZE_MIN = 32;
+const int SUB_BLOCK_SIZE_MAX = 512;
+const int SUB_BLOCK_SIZE_DEFAULT = 128;
+const int FADE_SPLIT_MIN_SUB_BLOCK_SIZE = 32; // a sub-block is only split at a fade's end if both parts are at least this long
+const float MINIMUM_LEVEL = 1.0e-10f; // keeps the detectors' log2() finite on silence, far below the lowest threshold
+const double THRESHOLD_SMOOTHING_SECONDS = 0.01; // threshold automation is ramped per sample over this long
+const int FIR_CROSSOVER_PARTITION_ORDER = 8; // 256 sample partitions
+const int FIR_CROSSOVER_PARTITIONS_ORDER = 4; // 16 partitions, 4095 tap kernels
+const int SPECTRAL_FFT_ORDER = 10; // 1024 sample frames, which is also the spectral engine's latency
+const int SPECTRAL_OVERLAP = 4; // frames overlapping any one sample, so a hop is a quarter of a frame
+const int BACKGROUND_BUILD_INTERVAL_MS = 10; // how often the builder thread looks for configurations to rebuild
+const int WORKER_THREADS_AUTOMATIC = -1; // none for mono and stereo, up to WORKER_THREADS_MAX for wider layouts
+const int WORKER_THREADS_MAX = 3;
+const int WORKER_POOL_MIN_BLOCK_SIZE = 64; // shorter sub-blocks are processed on the audio thread alone
+const int WORKER_POOL_SPIN_ITERATIONS = 4096; // polls before a worker sleeps, or the audio thread starts yielding
+const int WORKER_POOL_SLEEP_TIMEOUT_MS = 100;
+const float SILENCE_THRESHOLD_DB = -120.f; // input below this counts as silence, and the tail is over once it decays this far
+
 //==============================================================================
 // Units
 const juce::String HZ = "Hz";
@@ -97,6 +160,10 @@ const int FLEX_BAND_SELECT_WIDTH = 50;
 const int CONTROL_BAR_HEIGHT = 32;
 const int BAND_CONTROLS_HEIGHT = 135;
 const int ANALYZER_HEIGHT = 225;
+// the editor widens by one rotary per crossover, 600 wide for three bands
+const int EDITOR_WIDTH_PER_GLOBAL_SLIDER = 150;
+const int EDITOR_WIDTH = EDITOR_WIDTH_PER_GLOBAL_SLIDER * (NUM_BANDS + 1);
+const int EDITOR_HEIGHT = 500;
 
 const int DEFAULT_PADDING = 5;
 const int SLIDER_X_PADDING = 2;
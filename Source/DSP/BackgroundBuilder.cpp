@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    BackgroundBuilder.cpp
+    Created: 19 Oct 2026 1:16:13am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "BackgroundBuilder.h"
+#include "../Constants.h"
+
+BackgroundBuilder::BackgroundBuilder() : juce::Thread("SimpleMBComp Builder") {}
+
+BackgroundBuilder::~BackgroundBuilder() {
+    stopThread(-1);
+}
+
+void BackgroundBuilder::addJob(std::function<void()> job) {
+    jassert(!isThreadRunning());
+    jobs.push_back(std::move(job));
+}
+
+void BackgroundBuilder::run() {
+    while (!threadShouldExit()) {
+        for (auto& job : jobs) {
+            job();
+        }
+        wait(BACKGROUND_BUILD_INTERVAL_MS);
+    }
+}
@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    BackgroundBuilder.h
+    Created: 19 Oct 2026 1:16:13am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+//==============================================================================
+// Low priority thread that rebuilds DSP configurations too expensive to rebuild in processBlock, see ConfigExchange.
+// Every job is run in turn every BACKGROUND_BUILD_INTERVAL_MS. A job checks whether anything has changed, builds and
+// publishes a new configuration if it has, and frees the ones the audio thread has retired. The thread polls rather
+// than being woken, so the audio thread never has to signal it.
+struct BackgroundBuilder : juce::Thread {
+    BackgroundBuilder();
+    ~BackgroundBuilder() override;
+
+    // message thread, before the thread is first started
+    void addJob(std::function<void()> job);
+
+    void run() override;
+private:
+    std::vector<std::function<void()>> jobs;
+};
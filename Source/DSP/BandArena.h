@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    BandArena.h
+    Created: 19 Oct 2026 1:58:25am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+// Every band and channel of the split signal in one allocation. Lanes are laid out band by band, channel by channel,
+// in the same order as the compressor kernel's lanes, and every lane starts on a cache line a fixed stride after the
+// one before it. The stages that want juce::AudioBuffers get views that refer into the arena and never own samples.
+// Only prepare() allocates
+template<typename SampleType, int NumBands>
+struct BandArena {
+    using Buffer = juce::AudioBuffer<SampleType>;
+    using Bands = std::array<Buffer, NumBands>;
+
+    // a cache line, and the widest vector the kernels are built for
+    static constexpr size_t Alignment = 64;
+
+    void prepare(int channelsPerBand, int samplesPerLane) {
+        numChannels = channelsPerBand;
+        numSamples = samplesPerLane;
+        constexpr auto samplesPerAlignment = static_cast<int>(Alignment / sizeof(SampleType));
+        stride = (numSamples + samplesPerAlignment - 1) / samplesPerAlignment * samplesPerAlignment;
+
+        auto numLanes = static_cast<size_t>(NumBands * numChannels);
+        // the padding lets the first lane start on the alignment wherever the allocation lands
+        storage.allocate(numLanes * static_cast<size_t>(stride) + Alignment / sizeof(SampleType), true);
+        auto address = reinterpret_cast<std::uintptr_t>(storage.get());
+        auto* first = reinterpret_cast<SampleType*>((address + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1));
+
+        lanes.resize(numLanes);
+        for (size_t lane = 0; lane < numLanes; ++lane) {
+            lanes[lane] = first + lane * static_cast<size_t>(stride);
+        }
+    }
+
+    void clear() {
+        for (auto* lane : lanes) {
+            std::fill(lane, lane + numSamples, SampleType());
+        }
+    }
+
+    int getNumChannels() const { return numChannels; }
+    int getNumSamples() const { return numSamples; }
+    // samples from the start of one lane to the start of the next
+    int getStride() const { return stride; }
+
+    SampleType* getLane(int band, int chan) const {
+        jassert(band < NumBands && chan < numChannels);
+        return lanes[static_cast<size_t>(band * numChannels + chan)];
+    }
+
+    // the numChannels lane pointers of a band, then those of the bands above it
+    SampleType* const* getBandLanes(int band) const {
+        return lanes.data() + band * numChannels;
+    }
+
+    // Points views at numSamples of every band from startSample on. Views stay valid until the next prepare(), and
+    // as they never own their samples, repointing them on the audio thread doesn't free anything
+    void referTo(Bands& views, int startSample, int numSamplesInView) const {
+        jassert(startSample + numSamplesInView <= numSamples);
+        for (int band = 0; band < NumBands; ++band) {
+            views[static_cast<size_t>(band)].setDataToReferTo(getBandLanes(band), numChannels, startSample, numSamplesInView);
+        }
+    }
+private:
+    juce::HeapBlock<SampleType> storage;
+    std::vector<SampleType*> lanes;
+    int numChannels{ 0 };
+    int numSamples{ 0 };
+    int stride{ 0 };
+};
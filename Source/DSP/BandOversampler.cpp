@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    BandOversampler.cpp
+    Created: 19 Oct 2026 1:21:27am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "BandOversampler.h"
+
+void BandOversampler::prepare(double newSampleRate, int maximumBlockSize, int newNumChannels, bool useDoublePrecision) {
+    sampleRate = newSampleRate;
+    numChannels = newNumChannels;
+    usesDoublePrecision = useDoublePrecision;
+    maxLatencySamples = 0;
+
+    // the set for the other precision is freed, it would only hold memory
+    if (usesDoublePrecision) {
+        prepareOversamplers(doubleOversamplers, maximumBlockSize);
+        floatOversamplers = {};
+    } else {
+        prepareOversamplers(floatOversamplers, maximumBlockSize);
+        doubleOversamplers = {};
+    }
+}
+
+template<typename SampleType>
+void BandOversampler::prepareOversamplers(OversamplerSet<SampleType>& oversamplers, int maximumBlockSize) {
+    using Oversampling = juce::dsp::Oversampling<SampleType>;
+    for (size_t stages = 0; stages < oversamplers.size(); ++stages) {
+        for (size_t type = 0; type < oversamplers[stages].size(); ++type) {
+            auto filterType = static_cast<FilterType>(type) == FilterType::LinearPhaseFIR ? Oversampling::filterHalfBandFIREquiripple
+                                                                                           : Oversampling::filterHalfBandPolyphaseIIR;
+            auto& oversampler = oversamplers[stages][type];
+            oversampler = std::make_unique<Oversampling>(static_cast<size_t>(numChannels), stages + 1, filterType, true, true);
+            oversampler->initProcessing(static_cast<size_t>(maximumBlockSize));
+            maxLatencySamples = juce::jmax(maxLatencySamples, juce::roundToInt(oversampler->getLatencyInSamples()));
+        }
+    }
+}
+
+void BandOversampler::prepareKernels(int maxDelaySamples) {
+    for (size_t stages = 0; stages < kernels.size(); ++stages) {
+        auto rate = 2 << stages;
+        kernels[stages].prepare(sampleRate * rate, 1, numChannels, maxDelaySamples * rate);
+    }
+}
+
+void BandOversampler::reset() {
+    if (isActive()) {
+        if (usesDoublePrecision) {
+            getOversampler<double>().reset();
+        } else {
+            getOversampler<float>().reset();
+        }
+        getKernel().reset();
+    }
+}
+
+void BandOversampler::setMode(Factor newFactor, FilterType newFilter) {
+    if (newFactor != factor || newFilter != filter) {
+        factor = newFactor;
+        filter = newFilter;
+        reset();
+    }
+}
+
+int BandOversampler::getLatencySamples() const {
+    if (!isActive()) {
+        return 0;
+    }
+    auto latency = usesDoublePrecision ? getOversampler<double>().getLatencyInSamples()
+                                       : getOversampler<float>().getLatencyInSamples();
+    return juce::roundToInt(latency);
+}
+
+CompressorKernel& BandOversampler::getKernel() {
+    jassert(isActive());
+    return kernels[static_cast<size_t>(factor) - 1];
+}
+
+const CompressorKernel& BandOversampler::getKernel() const {
+    jassert(isActive());
+    return kernels[static_cast<size_t>(factor) - 1];
+}
+
+void BandOversampler::setChannelLinks(const int* linkGroups) {
+    for (auto& kernel : kernels) {
+        kernel.setChannelLinks(linkGroups);
+    }
+}
+
+void BandOversampler::setChannelMeterWeights(const float* weights) {
+    for (auto& kernel : kernels) {
+        kernel.setChannelMeterWeights(weights);
+    }
+}
+
+void BandOversampler::setSimdPath(SimdPath path) {
+    for (auto& kernel : kernels) {
+        kernel.setSimdPath(path);
+    }
+}
+
+template<typename SampleType>
+juce::dsp::Oversampling<SampleType>& BandOversampler::getOversampler() const {
+    jassert(isActive());
+    jassert((usesDoublePrecision == std::is_same<SampleType, double>::value));
+    const auto& oversamplers = [this]() -> const OversamplerSet<SampleType>& {
+        if constexpr (std::is_same<SampleType, double>::value) {
+            return doubleOversamplers;
+        } else {
+            return floatOversamplers;
+        }
+    }();
+    return *oversamplers[static_cast<size_t>(factor) - 1][static_cast<size_t>(filter)];
+}
+
+template<typename SampleType>
+void BandOversampler::process(juce::AudioBuffer<SampleType>& band) {
+    jassert(isActive());
+    auto block = juce::dsp::AudioBlock<SampleType>(band);
+    auto& oversampler = getOversampler<SampleType>();
+    auto upsampled = oversampler.processSamplesUp(block);
+
+    std::array<SampleType*, CompressorKernel::MaxLanes> lanes{};
+    for (size_t chan = 0; chan < upsampled.getNumChannels(); ++chan) {
+        lanes[chan] = upsampled.getChannelPointer(chan);
+    }
+    getKernel().process(lanes.data(), static_cast<int>(upsampled.getNumSamples()));
+
+    oversampler.processSamplesDown(block);
+}
+
+template void BandOversampler::process(juce::AudioBuffer<float>&);
+template void BandOversampler::process(juce::AudioBuffer<double>&);
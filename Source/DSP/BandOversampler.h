@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    BandOversampler.h
+    Created: 19 Oct 2026 1:21:27am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include "CompressorKernel.h"
+
+//==============================================================================
+// Runs one band's detector and gain stage at 2x or 4x the host rate, so fast attacks and steep ratios don't alias.
+// The band is upsampled, compressed by a kernel of its own running at the higher rate, then downsampled again. Only
+// the bands that ask for it pay for it, which is far cheaper than oversampling the whole plugin.
+// Every factor and filter is built in prepare(), so switching between them on the audio thread only resets the one
+// switched to. The band comes back getLatencySamples() late (whole samples, JUCE pads the filters' delay), and the
+// other bands are delayed to match.
+// The FIR filters are linear phase, so the bands still sum back exactly. The polyphase IIR ones have less latency
+// but shift the phase near the top of the band a little.
+// Only the oversamplers for the precision the host processes in are built, process() must be called with that one.
+struct BandOversampler {
+    // orders match OVERSAMPLING_CHOICES and OVERSAMPLING_FILTER_CHOICES
+    enum class Factor {
+        x1,
+        x2,
+        x4
+    };
+    enum class FilterType {
+        PolyphaseIIR,
+        LinearPhaseFIR
+    };
+
+    // builds every oversampler for the given precision, getMaxLatencySamples() is known after this
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, bool useDoublePrecision);
+    // every kernel's delay will fit maxDelaySamples, in host rate samples, see CompressorKernel::setLookaheadDelay()
+    void prepareKernels(int maxDelaySamples);
+    void reset();
+
+    // resets the oversampler and kernel switched to
+    void setMode(Factor factor, FilterType filter);
+    bool isActive() const { return factor != Factor::x1; }
+    int getFactor() const { return 1 << static_cast<int>(factor); }
+
+    // in host rate samples, 0 while not active
+    int getLatencySamples() const;
+    // of the slowest factor and filter
+    int getMaxLatencySamples() const { return maxLatencySamples; }
+
+    // The kernel compressing the band at the current factor. It has a single band and runs at the oversampled rate,
+    // so delays and lookaheads given to it are in oversampled samples
+    CompressorKernel& getKernel();
+    const CompressorKernel& getKernel() const;
+    // for every factor's kernel, see CompressorKernel
+    void setChannelLinks(const int* linkGroups);
+    void setChannelMeterWeights(const float* weights);
+    void setSimdPath(SimdPath path);
+
+    // compresses the band in place, only while active
+    template<typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& band);
+private:
+    // [factor][filter], for 2x and 4x
+    template<typename SampleType>
+    using OversamplerSet = std::array<std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, 2>, 2>;
+
+    Factor factor{ Factor::x1 };
+    FilterType filter{ FilterType::PolyphaseIIR };
+
+    double sampleRate{ 44100.0 };
+    int numChannels{ 0 };
+    int maxLatencySamples{ 0 };
+    bool usesDoublePrecision{ false };
+
+    OversamplerSet<float> floatOversamplers;
+    OversamplerSet<double> doubleOversamplers;
+    std::array<CompressorKernel, 2> kernels;
+
+    template<typename SampleType>
+    void prepareOversamplers(OversamplerSet<SampleType>& oversamplers, int maximumBlockSize);
+    template<typename SampleType>
+    juce::dsp::Oversampling<SampleType>& getOversampler() const;
+};
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    BandPipeline.h
+    Created: 19 Oct 2026 1:42:17am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "BandArena.h"
+
+//==============================================================================
+// The split bands of the pipelined mode. A sub-block's bands go in at the write end and come out latency samples
+// later at the read end, and as a sub-block is never longer than the latency the two ends never overlap, so one
+// sub-block can be split on the helper thread while the previous one is compressed.
+// The storage is three latencies long. When the write end runs out of room the unread samples move back to the
+// start, at most once every latency samples
+template<typename SampleType, int NumBands>
+struct BandPipeline {
+    using Buffer = juce::AudioBuffer<SampleType>;
+    using Bands = std::array<Buffer, NumBands>;
+
+    void prepare(int numChannels, int latencySamples) {
+        latency = latencySamples;
+        storage.prepare(numChannels, 3 * latency);
+        reset();
+    }
+
+    // the first latency samples out are silence
+    void reset() {
+        storage.clear();
+        readPosition = 0;
+    }
+
+    int getLatencySamples() const { return latency; }
+
+    // Points readBands at the numSamples that went in latency samples ago, and writeBands at the room for the next
+    // numSamples. The views only stay valid until endSubBlock()
+    void beginSubBlock(int numSamples, Bands& readBands, Bands& writeBands) {
+        jassert(numSamples <= latency);
+        auto writePosition = readPosition + latency;
+        if (writePosition + numSamples > storage.getNumSamples()) {
+            for (int band = 0; band < NumBands; ++band) {
+                for (int chan = 0; chan < storage.getNumChannels(); ++chan) {
+                    auto* samples = storage.getLane(band, chan);
+                    std::copy(samples + readPosition, samples + writePosition, samples);
+                }
+            }
+            readPosition = 0;
+            writePosition = latency;
+        }
+
+        storage.referTo(readBands, readPosition, numSamples);
+        storage.referTo(writeBands, writePosition, numSamples);
+    }
+
+    void endSubBlock(int numSamples) {
+        readPosition += numSamples;
+    }
+private:
+    BandArena<SampleType, NumBands> storage;
+    int latency{ 0 };
+    int readPosition{ 0 };
+};
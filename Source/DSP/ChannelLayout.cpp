@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    ChannelLayout.cpp
+    Created: 19 Oct 2026 1:31:32am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "ChannelLayout.h"
+
+namespace {
+    using Type = juce::AudioChannelSet::ChannelType;
+
+    enum class Side {
+        Left,
+        Right,
+        Centre,
+        None
+    };
+
+    Side getSide(Type type) {
+        switch (type) {
+            case Type::left:
+            case Type::leftSurround:
+            case Type::leftSurroundSide:
+            case Type::leftSurroundRear:
+            case Type::topFrontLeft:
+            case Type::topRearLeft:
+                return Side::Left;
+            case Type::right:
+            case Type::rightSurround:
+            case Type::rightSurroundSide:
+            case Type::rightSurroundRear:
+            case Type::topFrontRight:
+            case Type::topRearRight:
+                return Side::Right;
+            case Type::LFE:
+                return Side::None;
+            default:
+                return Side::Centre;
+        }
+    }
+
+    // Channels with the same key share a detector. Keys below 0 stand alone
+    int getLinkKey(Type type, ChannelLayout::Link link) {
+        if (type == Type::LFE || link == ChannelLayout::Link::Independent) {
+            return -1;
+        }
+        if (link == ChannelLayout::Link::All) {
+            return 0;
+        }
+
+        switch (type) {
+            case Type::left:
+            case Type::right:
+                return 1;
+            case Type::leftSurround:
+            case Type::rightSurround:
+                return 2;
+            case Type::leftSurroundSide:
+            case Type::rightSurroundSide:
+                return link == ChannelLayout::Link::Groups ? 2 : 3;
+            case Type::leftSurroundRear:
+            case Type::rightSurroundRear:
+                return link == ChannelLayout::Link::Groups ? 2 : 4;
+            case Type::topFrontLeft:
+            case Type::topFrontRight:
+                return 5;
+            case Type::topRearLeft:
+            case Type::topRearRight:
+                return link == ChannelLayout::Link::Groups ? 5 : 6;
+            case Type::centre:
+                return link == ChannelLayout::Link::Groups ? 1 : -1;
+            default:
+                return -1;
+        }
+    }
+
+    float getMeterWeight(Type type) {
+        switch (type) {
+            case Type::LFE:
+                return 0.f;
+            // between 60 and 120 degrees off axis
+            case Type::leftSurround:
+            case Type::rightSurround:
+            case Type::leftSurroundSide:
+            case Type::rightSurroundSide:
+                return 1.41f;
+            default:
+                return 1.f;
+        }
+    }
+}
+
+bool ChannelLayout::isSupported(const juce::AudioChannelSet& layout) {
+    return layout == juce::AudioChannelSet::mono()
+        || layout == juce::AudioChannelSet::stereo()
+        || layout == juce::AudioChannelSet::create5point1()
+        || layout == juce::AudioChannelSet::create7point1()
+        || layout == juce::AudioChannelSet::create7point1point4();
+}
+
+void ChannelLayout::prepare(const juce::AudioChannelSet& layout) {
+    jassert(layout.size() <= MAX_CHANNELS);
+    types = layout.getChannelTypes();
+    types.resize(juce::jmin(types.size(), MAX_CHANNELS));
+    numChannels = types.size();
+
+    for (int link = 0; link < NumLinks; ++link) {
+        auto& groups = linkGroups[static_cast<size_t>(link)];
+        for (int chan = 0; chan < MAX_CHANNELS; ++chan) {
+            groups[static_cast<size_t>(chan)] = chan;
+        }
+        for (int chan = 0; chan < numChannels; ++chan) {
+            auto key = getLinkKey(types[chan], static_cast<Link>(link));
+            if (key < 0) {
+                continue;
+            }
+            // the first channel found with the same key leads the group
+            for (int other = 0; other < chan; ++other) {
+                if (getLinkKey(types[other], static_cast<Link>(link)) == key) {
+                    groups[static_cast<size_t>(chan)] = groups[static_cast<size_t>(other)];
+                    break;
+                }
+            }
+        }
+    }
+
+    meterWeights.fill(0.f);
+    for (int chan = 0; chan < numChannels; ++chan) {
+        meterWeights[static_cast<size_t>(chan)] = getMeterWeight(types[chan]);
+    }
+}
+
+void ChannelLayout::configureAnalyzerTap(SingleChannelSampleFifo<juce::AudioBuffer<float>>& fifo, Channel channel) const {
+    // mono and stereo read the one channel, as they always have
+    if (numChannels <= 2) {
+        fifo.setSourceChannels({ juce::jmin(static_cast<int>(channel), numChannels - 1) });
+        return;
+    }
+
+    auto side = getSide(types[static_cast<int>(channel)]);
+    juce::Array<int> channels;
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto chanSide = getSide(types[chan]);
+        if (chanSide == side || chanSide == Side::Centre) {
+            channels.add(chan);
+        }
+    }
+    fifo.setSourceChannels(channels);
+}
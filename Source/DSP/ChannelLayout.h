@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ChannelLayout.h
+    Created: 19 Oct 2026 1:31:32am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "../Constants.h"
+#include "SingleChannelSampleFifo.h"
+
+//==============================================================================
+// Works out what the engine needs to know about the bus layout: which channels share a detector, how much each one
+// counts towards the band meters, and which ones feed each analyzer trace.
+// Supports mono, stereo, 5.1, 7.1 and 7.1.4, everything is worked out in prepare() so the audio thread only looks it up.
+struct ChannelLayout {
+    // order matches CHANNEL_LINK_CHOICES
+    enum class Link {
+        Independent, // every channel has its own detector
+        StereoPairs, // L/R, Ls/Rs, Lrs/Rrs, Ltf/Rtf... are linked, centre and LFE stand alone
+        Groups,      // the front (L/C/R), the surrounds and the heights are each linked, the LFE stands alone
+        All          // every channel but the LFE is linked
+    };
+    static constexpr int NumLinks = 4;
+
+    // [channel] = the lowest channel of its link group
+    using LinkGroups = std::array<int, MAX_CHANNELS>;
+
+    static bool isSupported(const juce::AudioChannelSet& layout);
+
+    // message thread
+    void prepare(const juce::AudioChannelSet& layout);
+
+    int getNumChannels() const { return numChannels; }
+    const LinkGroups& getLinkGroups(Link link) const { return linkGroups[static_cast<size_t>(link)]; }
+    // ITU-R BS.1770 channel weights: the side surrounds count 1.5 dB more, the LFE doesn't count at all
+    const std::array<float, MAX_CHANNELS>& getMeterWeights() const { return meterWeights; }
+
+    // The analyzer draws two traces, with more than two channels each is the mix of one side of the layout.
+    // A trace follows the side of the stereo channel it was built for, the centres go into both and the LFE into neither
+    void configureAnalyzerTap(SingleChannelSampleFifo<juce::AudioBuffer<float>>& fifo, Channel channel) const;
+private:
+    int numChannels{ 0 };
+    juce::Array<juce::AudioChannelSet::ChannelType> types;
+    std::array<LinkGroups, NumLinks> linkGroups{};
+    std::array<float, MAX_CHANNELS> meterWeights{};
+};
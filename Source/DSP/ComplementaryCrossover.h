@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    ComplementaryCrossover.h
+    Created: 19 Oct 2026 1:04:46am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "CrossoverFilter.h"
+#include "CrossoverTree.h"
+
+//==============================================================================
+// Splits a signal into NumBands bands with one band, Derived, taken by subtraction from an all pass aligned reference
+// instead of running its own filters. Every other band is still split by Linkwitz-Riley filters, aligned with all passes
+// like the CrossoverTree's bands. With 3 bands:
+//     low = LP0 * AP1 (x), high = HP1 * AP0 (x), mid = AP0 * AP1 (x) - low - high
+// which leaves mid = HP0 * LP1 - HP1 * LP0 (aligned by the all passes), so every band's skirts fall at its own
+// crossovers' Linkwitz-Riley slopes and the bands still sum to the same all pass as the tree's. The outer bands aren't
+// also cut by the far crossovers the way the tree's are: at 400 Hz and 2 kHz the mid band is -48 dB at 100 Hz like the
+// tree's, the high band -80 dB at 200 Hz against the tree's -105 dB.
+// The reference comes for free: the split above the derived band already produces AP(x) as the sum of its outputs, and
+// splitting that sum again at the crossover below gives the lower bands and, as its high output, the derived band plus
+// everything above it. So the derived band is that high output minus the upper bands, and no filter runs for it. The
+// other bands need the same filters they would in the tree, so the filter work and the time taken come out the same.
+// Tests/Source/CrossoverTests.cpp checks the sum and the isolation and benchmarks both. Same interface as CrossoverTree.
+template<typename SampleType, int NumBands>
+struct ComplementaryCrossover {
+    static_assert(NumBands >= 2, "a crossover needs at least two bands");
+    static constexpr int NumCrossovers = NumBands - 1;
+
+    // the middle band, or the upper one of two
+    static constexpr int Derived = NumBands / 2;
+    static constexpr int LowBands = Derived;
+    static constexpr int HighBands = NumBands - Derived - 1;
+
+    using Filter = CrossoverFilter<SampleType>;
+    using Buffer = juce::AudioBuffer<SampleType>;
+
+    // Bands 0 to Derived - 1 and Derived + 1 up, each split like the CrossoverTree does. With 2 bands there is no
+    // upper half, its node is a leaf that is never run
+    using LowNode = CrossoverNode<SampleType, 0, LowBands>;
+    using HighNode = CrossoverNode<SampleType, Derived + 1, std::max(1, HighBands)>;
+
+    void prepare(const juce::dsp::ProcessSpec& spec) {
+        forEachOwnFilter([&spec](Filter& filter) { filter.prepare(spec); });
+        low.prepare(spec);
+        high.prepare(spec);
+        upperSplitIsWarm = upperIsWarm = referenceIsWarm = lowerSplitIsWarm = derivedIsWarm = true;
+    }
+
+    void reset() {
+        forEachOwnFilter([](Filter& filter) { filter.reset(); });
+        low.reset();
+        high.reset();
+    }
+
+    // index 0 is the lowest crossover
+    void setCutoffFrequency(int index, SampleType frequency) {
+        jassert(juce::isPositiveAndBelow(index, NumCrossovers));
+        forEachFilter(index, [frequency](Filter& filter) { filter.setCutoffFrequency(frequency); });
+    }
+
+    void setSlope(int index, CrossoverSlope slope) {
+        jassert(juce::isPositiveAndBelow(index, NumCrossovers));
+        forEachFilter(index, [slope](Filter& filter) { filter.setSlope(slope); });
+    }
+
+    // bands[0] holds the input on entry, every band buffer must already be the same size as it.
+    // Filters that only feed bands that aren't needed are skipped, and reset once they are needed again
+    void process(std::array<Buffer, NumBands>& bands, const std::array<bool, NumBands>& bandNeeded) {
+        prepareBlock(bandNeeded);
+        std::array<SampleType* const*, NumBands> channels{};
+        for (size_t band = 0; band < bands.size(); ++band) {
+            channels[band] = bands[band].getArrayOfWritePointers();
+        }
+        for (int chan = 0; chan < bands[0].getNumChannels(); ++chan) {
+            processChannel(channels, chan, bands[0].getNumSamples());
+        }
+    }
+
+    // The same as process() split in two, so the channels can be shared out between threads, see CrossoverTree
+    void prepareBlock(const std::array<bool, NumBands>& bandNeeded) {
+        // the derived band is what is left once the upper bands are taken away, so it needs all of them
+        auto needed = bandNeeded;
+        derivedNeeded = bandNeeded[static_cast<size_t>(Derived)];
+        for (auto band = static_cast<size_t>(Derived + 1); band < needed.size(); ++band) {
+            needed[band] = needed[band] || derivedNeeded;
+        }
+        anyNeeded = std::any_of(needed.begin(), needed.end(), [](bool isNeeded) { return isNeeded; });
+        upperNeeded = std::any_of(needed.begin() + Derived + 1, needed.end(), [](bool isNeeded) { return isNeeded; });
+        referenceNeeded = std::any_of(needed.begin(), needed.begin() + Derived + 1, [](bool isNeeded) { return isNeeded; });
+
+        auto warm = [](auto& filters, bool& filtersAreWarm, bool isNeeded) {
+            if (isNeeded && !filtersAreWarm) {
+                for (auto& filter : filters) {
+                    filter.reset();
+                }
+            }
+            filtersAreWarm = isNeeded;
+        };
+        // the upper split makes the reference, so it runs whenever anything does
+        warm(upperSplit, upperSplitIsWarm, anyNeeded);
+        warm(upperAlignment, upperIsWarm, upperNeeded);
+        warm(referenceAlignment, referenceIsWarm, referenceNeeded);
+        warm(lowerSplit, lowerSplitIsWarm, referenceNeeded);
+        warm(derivedAlignment, derivedIsWarm, derivedNeeded);
+
+        low.prepareBlock(needed);
+        high.prepareBlock(needed);
+    }
+
+    void processChannel(const std::array<SampleType* const*, NumBands>& bands, int chan, int numSamples) {
+        if (!anyNeeded) {
+            return;
+        }
+        auto* reference = bands[0][chan];
+        auto* derived = bands[static_cast<size_t>(Derived)][chan];
+
+        if constexpr (HighBands > 0) {
+            // the split's outputs sum to the all pass of its crossover, which starts the reference
+            auto* upper = bands[static_cast<size_t>(Derived + 1)][chan];
+            upperSplit[0].split(chan, reference, reference, upper, numSamples);
+            juce::FloatVectorOperations::add(reference, upper, numSamples);
+
+            if (upperNeeded) {
+                for (auto& allpass : upperAlignment) {
+                    allpass.allpass(chan, upper, numSamples);
+                }
+                high.processChannel(bands, chan, numSamples);
+            }
+            if (referenceNeeded) {
+                for (auto& allpass : referenceAlignment) {
+                    allpass.allpass(chan, reference, numSamples);
+                }
+            }
+        }
+        if (!referenceNeeded) {
+            return;
+        }
+
+        // the low output is the lower bands' input, the high output the derived band plus the upper bands
+        lowerSplit[0].split(chan, reference, reference, derived, numSamples);
+        low.processChannel(bands, chan, numSamples);
+
+        if (derivedNeeded) {
+            for (auto& allpass : derivedAlignment) {
+                allpass.allpass(chan, derived, numSamples);
+            }
+            for (auto band = static_cast<size_t>(Derived + 1); band < bands.size(); ++band) {
+                juce::FloatVectorOperations::subtract(derived, bands[band][chan], numSamples);
+            }
+        }
+    }
+private:
+    static constexpr size_t NumUpperSplits = HighBands > 0 ? 1 : 0;
+    static constexpr size_t NumUpperAllpasses = HighBands > 0 ? static_cast<size_t>(Derived) : 0;
+    static constexpr size_t NumReferenceAllpasses = static_cast<size_t>(std::max(0, HighBands - 1));
+
+    // an empty array where there is no upper half
+    std::array<Filter, NumUpperSplits> upperSplit;                   // at crossover Derived
+    std::array<Filter, NumUpperAllpasses> upperAlignment;            // the crossovers below it, on the upper bands
+    std::array<Filter, NumReferenceAllpasses> referenceAlignment;    // the crossovers above it, on the reference
+    std::array<Filter, 1> lowerSplit;                                // at crossover Derived - 1
+    std::array<Filter, static_cast<size_t>(Derived - 1)> derivedAlignment; // the crossovers below that, on the derived band
+    LowNode low;
+    HighNode high;
+
+    bool upperSplitIsWarm{ true };
+    bool upperIsWarm{ true };
+    bool referenceIsWarm{ true };
+    bool lowerSplitIsWarm{ true };
+    bool derivedIsWarm{ true };
+    // this block, see prepareBlock()
+    bool anyNeeded{ false };
+    bool upperNeeded{ false };
+    bool referenceNeeded{ false };
+    bool derivedNeeded{ false };
+
+    template<typename Fn>
+    void forEachOwnFilter(Fn&& fn) {
+        auto each = [&fn](auto& filters) {
+            for (auto& filter : filters) {
+                fn(filter);
+            }
+        };
+        each(upperSplit);
+        each(upperAlignment);
+        each(referenceAlignment);
+        each(lowerSplit);
+        each(derivedAlignment);
+    }
+
+    // every filter that belongs to crossover index
+    template<typename Fn>
+    void forEachFilter(int index, Fn&& fn) {
+        if constexpr (HighBands > 0) {
+            if (index == Derived) {
+                fn(upperSplit[0]);
+            }
+            else if (index > Derived) {
+                fn(referenceAlignment[static_cast<size_t>(index - Derived - 1)]);
+            }
+            else {
+                fn(upperAlignment[static_cast<size_t>(index)]);
+            }
+        }
+        if (index < Derived) {
+            if (index == Derived - 1) {
+                fn(lowerSplit[0]);
+            }
+            else {
+                fn(derivedAlignment[static_cast<size_t>(index)]);
+            }
+        }
+        low.forEachFilter(index, fn);
+        high.forEachFilter(index, fn);
+    }
+};
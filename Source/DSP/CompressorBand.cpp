@@ -9,32 +9,69 @@
 */
 
 #include "CompressorBand.h"
+#include "FastMath.h"
 
-void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec) {
-    compressor.prepare(spec);
-}
+namespace {
+    struct ControlRate {
+        int intervalSamples;
+        CompressorKernel::GainInterpolation interpolation;
+    };
 
-void CompressorBand::updateCompressorSettings() {
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
+    // one per CONTROL_RATE_CHOICES
+    const std::array<ControlRate, 5> CONTROL_RATES{ {
+        { 1, CompressorKernel::GainInterpolation::Linear },
+        { 8, CompressorKernel::GainInterpolation::Linear },
+        { 8, CompressorKernel::GainInterpolation::Cubic },
+        { 16, CompressorKernel::GainInterpolation::Linear },
+        { 16, CompressorKernel::GainInterpolation::Cubic }
+    } };
 }
 
-void CompressorBand::process(juce::AudioBuffer<float>& buffer) {
-    auto preRMS = computeRMSLevel(buffer);
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-
-    context.isBypassed = bypassed->get();
+void CompressorBand::updateCompressorSettings(CompressorKernel& kernel, int band) {
+    // index straight into the choices, parsing the choice name every block is wasted work
+    auto ratioValue = static_cast<float>(RATIO_CHOICES[static_cast<size_t>(ratio->getIndex())]);
+    kernel.setBandParameters(band, attack->get(), release->get(), threshold->get(), ratioValue, bypassed->get());
+    const auto& rate = CONTROL_RATES[static_cast<size_t>(controlRate->getIndex())];
+    kernel.setBandControlRate(band, rate.intervalSamples, rate.interpolation);
+}
 
-    compressor.process(context);
+void CompressorBand::updateCompressorSettings(SpectralCompressor<NUM_BANDS>& engine, int band) {
+    auto ratioValue = static_cast<float>(RATIO_CHOICES[static_cast<size_t>(ratio->getIndex())]);
+    engine.setBandParameters(band, attack->get(), release->get(), threshold->get(), ratioValue, bypassed->get());
+}
 
-    auto postRMS = computeRMSLevel(buffer);
+void CompressorBand::updateMeters(const CompressorKernel::BandLevels& levels) {
+    // floored like every other meter in the plugin, so silent and skipped bands read the same as a quiet input
     auto convertToDb = [](auto input) {
-        return juce::Decibels::gainToDecibels(input);
+        return FastMath::gainToDecibels(input, NEGATIVE_INFINITY);
     };
 
-    rmsInputLevelDb.store(convertToDb(preRMS));
-    rmsOutputLevelDb.store(convertToDb(postRMS));
-}
\ No newline at end of file
+    auto sequence = meterSequence.load(std::memory_order_relaxed);
+    meterSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    rmsInputLevelDb.store(convertToDb(levels.inputRms), std::memory_order_relaxed);
+    rmsOutputLevelDb.store(convertToDb(levels.outputRms), std::memory_order_relaxed);
+    peakInputLevelDb.store(convertToDb(levels.inputPeak), std::memory_order_relaxed);
+    peakOutputLevelDb.store(convertToDb(levels.outputPeak), std::memory_order_relaxed);
+    gainReductionPeakDb.store(convertToDb(levels.minimumGain), std::memory_order_relaxed);
+
+    meterSequence.store(sequence + 2, std::memory_order_release);
+}
+
+CompressorBand::MeterSnapshot CompressorBand::getMeterSnapshot() const {
+    MeterSnapshot snapshot;
+    uint32_t before, after;
+    do {
+        before = meterSequence.load(std::memory_order_acquire);
+        snapshot.rmsInputLevelDb = rmsInputLevelDb.load(std::memory_order_relaxed);
+        snapshot.rmsOutputLevelDb = rmsOutputLevelDb.load(std::memory_order_relaxed);
+        snapshot.peakInputLevelDb = peakInputLevelDb.load(std::memory_order_relaxed);
+        snapshot.peakOutputLevelDb = peakOutputLevelDb.load(std::memory_order_relaxed);
+        snapshot.gainReductionPeakDb = gainReductionPeakDb.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = meterSequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0 || before != after);
+
+    return snapshot;
+}
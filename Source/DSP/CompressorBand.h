@@ -11,7 +11,10 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../Constants.h"
+#include "CompressorKernel.h"
+#include "SpectralCompressor.h"
 
+// Holds the parameters and meters of one band. The compression itself is done for all bands at once by the CompressorKernel
 struct CompressorBand {
 public:
     juce::AudioParameterFloat* attack{ nullptr };
@@ -21,30 +24,33 @@ public:
     juce::AudioParameterBool* bypassed{ nullptr };
     juce::AudioParameterBool* mute{ nullptr };
     juce::AudioParameterBool* solo{ nullptr };
-
-    void prepare(const juce::dsp::ProcessSpec& spec);
-
-    void updateCompressorSettings();
-
-    void process(juce::AudioBuffer<float>& buffer);
-
-    float getRmsInputLevelDb() const { return rmsInputLevelDb; }
-    float getRmsOutputLevelDb() const { return rmsOutputLevelDb; }
+    juce::AudioParameterFloat* lookahead{ nullptr }; // ms, applied once per host block as it changes the latency
+    juce::AudioParameterChoice* oversampling{ nullptr }; // so is this
+    juce::AudioParameterChoice* controlRate{ nullptr }; // one of CONTROL_RATE_CHOICES, see CompressorKernel::setBandControlRate()
+
+    void updateCompressorSettings(CompressorKernel& kernel, int band);
+    // the same settings for the spectral bands centred in this band
+    void updateCompressorSettings(SpectralCompressor<NUM_BANDS>& engine, int band);
+
+    // Everything the GUI shows for one band, all from the same block
+    struct MeterSnapshot {
+        float rmsInputLevelDb{ NEGATIVE_INFINITY };
+        float rmsOutputLevelDb{ NEGATIVE_INFINITY };
+        float peakInputLevelDb{ NEGATIVE_INFINITY };
+        float peakOutputLevelDb{ NEGATIVE_INFINITY };
+        float gainReductionPeakDb{ 0.f };
+    };
+
+    // audio thread, levels come out of the kernel's gain loop so the band is never read twice for the meters
+    void updateMeters(const CompressorKernel::BandLevels& levels);
+    // any thread, never blocks the audio thread
+    MeterSnapshot getMeterSnapshot() const;
 private:
-    juce::dsp::Compressor<float> compressor;
+    // Sequence lock: odd while the audio thread is writing, readers retry until they see the same even value on both sides
+    std::atomic<uint32_t> meterSequence{ 0 };
     std::atomic<float> rmsInputLevelDb{ NEGATIVE_INFINITY };
     std::atomic<float> rmsOutputLevelDb{ NEGATIVE_INFINITY };
-
-    template<typename T>
-    float computeRMSLevel(const T& buffer) {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for (int chan = 0; chan < numChannels; ++chan) {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
-        }
-
-        rms /= static_cast<float>(numChannels);
-        return rms;
-    }
+    std::atomic<float> peakInputLevelDb{ NEGATIVE_INFINITY };
+    std::atomic<float> peakOutputLevelDb{ NEGATIVE_INFINITY };
+    std::atomic<float> gainReductionPeakDb{ 0.f };
 };
@@ -0,0 +1,355 @@
+/*
+  ==============================================================================
+
+    CompressorKernel.cpp
+    Created: 19 Oct 2026 12:42:45am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "CompressorKernel.h"
+#include "../Constants.h"
+#include "CompressorKernelBody.h"
+
+void CompressorKernel::prepare(double newSampleRate, int newNumBands, int newNumChannels, int maxLookaheadSamples) {
+    jassert(newNumBands * newNumChannels <= MaxLanes);
+    sampleRate = newSampleRate;
+    numBands = newNumBands;
+    numChannels = newNumChannels;
+    numLanes = juce::jmin(numBands * numChannels, MaxLanes);
+    paddedLanes = juce::jmin(MaxLanes, (numLanes + RegisterLanes - 1) / RegisterLanes * RegisterLanes);
+
+    // unused lanes never reduce gain
+    attackCte.fill(0.f);
+    releaseCte.fill(0.f);
+    thresholdLog2.fill(0.f);
+    thresholdTargetLog2.fill(0.f);
+    thresholdStep.fill(0.f);
+    thresholdRampRemaining.fill(-1); // the first threshold after prepare() is taken as is
+    thresholdRampSamples = juce::jmax(1, static_cast<int>(THRESHOLD_SMOOTHING_SECONDS * sampleRate));
+    slope.fill(0.f);
+    controlInterval.fill(1);
+    interpolation.fill(GainInterpolation::Linear);
+    updateEverySampleRegisters();
+
+    // room for the longest delay plus the tile being written
+    auto historySize = juce::nextPowerOfTwo(juce::jmax(0, maxLookaheadSamples) + TileSize);
+    history.setSize(juce::jmax(1, numLanes), historySize);
+    historyMask = historySize - 1;
+    lookaheadDelay = 0;
+    laneLookahead.fill(0);
+    updateDetectorDelays();
+
+    for (size_t lane = 0; lane < linkedLane.size(); ++lane) {
+        linkedLane[lane] = static_cast<int>(lane);
+    }
+    anyLanesLinked = false;
+    meterWeight.fill(1.f);
+
+    reset();
+    resetMeters();
+}
+
+void CompressorKernel::reset() {
+    envelope.fill(0.f);
+    gainReductionDb.fill(0.f);
+    lastControlGain.fill(1.f);
+    previousControlGain.fill(1.f);
+    for (auto& samples : inputTile) {
+        samples.fill(0.f);
+    }
+    for (auto& samples : audioTile) {
+        samples.fill(0.f);
+    }
+    history.clear();
+    historyWritePos = 0;
+}
+
+void CompressorKernel::resetBand(int band) {
+    jassert(juce::isPositiveAndBelow(band, numBands));
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto lane = static_cast<size_t>(band * numChannels + chan);
+        envelope[lane] = 0.f;
+        gainReductionDb[lane] = 0.f;
+        lastControlGain[lane] = 1.f;
+        previousControlGain[lane] = 1.f;
+        history.clear(static_cast<int>(lane), 0, history.getNumSamples());
+    }
+}
+
+float CompressorKernel::calculateCte(float timeMs) const {
+    // same time constant as juce::dsp::BallisticsFilter
+    if (timeMs < 1.0e-3f) {
+        return 0.f;
+    }
+    auto expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate;
+    return static_cast<float>(std::exp(expFactor / timeMs));
+}
+
+void CompressorKernel::setBandParameters(int band, float attackMs, float releaseMs, float thresholdDb, float ratio, bool bypassed) {
+    jassert(juce::isPositiveAndBelow(band, numBands));
+    jassert(ratio >= 1.f);
+
+    auto at = calculateCte(attackMs);
+    auto rl = calculateCte(releaseMs);
+    auto thr = std::log2(juce::Decibels::decibelsToGain(thresholdDb, -200.f));
+    // a bypassed band keeps following its envelope, but a zero slope means it never reduces gain
+    auto s = bypassed ? 0.f : (1.f / ratio) - 1.f;
+
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto lane = static_cast<size_t>(band * numChannels + chan);
+        attackCte[lane] = at;
+        releaseCte[lane] = rl;
+        slope[lane] = s;
+
+        if (thresholdRampRemaining[lane] < 0) {
+            thresholdLog2[lane] = thresholdTargetLog2[lane] = thr;
+            thresholdRampRemaining[lane] = 0;
+        }
+        else if (thr != thresholdTargetLog2[lane]) {
+            thresholdTargetLog2[lane] = thr;
+            thresholdStep[lane] = (thr - thresholdLog2[lane]) / static_cast<float>(thresholdRampSamples);
+            thresholdRampRemaining[lane] = thresholdRampSamples;
+        }
+    }
+}
+
+void CompressorKernel::setBandControlRate(int band, int intervalSamples, GainInterpolation newInterpolation) {
+    jassert(juce::isPositiveAndBelow(band, numBands));
+    jassert(juce::isPowerOfTwo(intervalSamples) && intervalSamples <= TileSize);
+    intervalSamples = juce::jlimit(1, TileSize, intervalSamples);
+
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto lane = static_cast<size_t>(band * numChannels + chan);
+        controlInterval[lane] = intervalSamples;
+        interpolation[lane] = newInterpolation;
+    }
+
+    updateEverySampleRegisters();
+}
+
+void CompressorKernel::updateEverySampleRegisters() {
+    numEverySampleRegisters = 0;
+    for (int firstLane = 0; firstLane < paddedLanes; firstLane += RegisterLanes) {
+        const auto registerEnd = juce::jmin(firstLane + RegisterLanes, numLanes);
+        if (std::any_of(controlInterval.begin() + firstLane, controlInterval.begin() + registerEnd, [](int interval) { return interval == 1; })) {
+            everySampleRegisters[static_cast<size_t>(numEverySampleRegisters++)] = firstLane;
+        }
+    }
+}
+
+void CompressorKernel::setLookaheadDelay(int delaySamples) {
+    jassert(delaySamples >= 0 && delaySamples + TileSize <= history.getNumSamples());
+    delaySamples = juce::jlimit(0, history.getNumSamples() - TileSize, delaySamples);
+    // the history isn't written while there's no delay, what is left in it is long out of date
+    if (lookaheadDelay == 0 && delaySamples > 0) {
+        history.clear();
+    }
+    lookaheadDelay = delaySamples;
+    updateDetectorDelays();
+}
+
+void CompressorKernel::setBandLookahead(int band, int lookaheadSamples) {
+    jassert(juce::isPositiveAndBelow(band, numBands));
+    for (int chan = 0; chan < numChannels; ++chan) {
+        laneLookahead[static_cast<size_t>(band * numChannels + chan)] = juce::jmax(0, lookaheadSamples);
+    }
+    updateDetectorDelays();
+}
+
+void CompressorKernel::updateDetectorDelays() {
+    for (size_t lane = 0; lane < detectorDelay.size(); ++lane) {
+        detectorDelay[lane] = lookaheadDelay - juce::jmin(laneLookahead[lane], lookaheadDelay);
+    }
+}
+
+void CompressorKernel::setChannelLinks(const int* linkGroups) {
+    anyLanesLinked = false;
+    for (int band = 0; band < numBands; ++band) {
+        for (int chan = 0; chan < numChannels; ++chan) {
+            jassert(juce::isPositiveAndNotGreaterThan(linkGroups[chan], chan));
+            auto leader = juce::jlimit(0, chan, linkGroups[chan]);
+            linkedLane[static_cast<size_t>(band * numChannels + chan)] = band * numChannels + leader;
+            anyLanesLinked = anyLanesLinked || leader != chan;
+        }
+    }
+}
+
+void CompressorKernel::setChannelMeterWeights(const float* weights) {
+    for (int band = 0; band < numBands; ++band) {
+        for (int chan = 0; chan < numChannels; ++chan) {
+            meterWeight[static_cast<size_t>(band * numChannels + chan)] = weights[chan];
+        }
+    }
+}
+
+void CompressorKernel::linkDetectors(int tileSamples) {
+    // Every lane of a group is replaced by the loudest one. The leader is always the lowest lane of its group, so one
+    // pass gathers the loudest into the leaders and a second hands it back out
+    for (int i = 0; i < tileSamples; ++i) {
+        auto& x = inputTile[static_cast<size_t>(i)];
+        for (int lane = 0; lane < numLanes; ++lane) {
+            auto& leader = x[static_cast<size_t>(linkedLane[static_cast<size_t>(lane)])];
+            leader = juce::jmax(std::abs(leader), std::abs(x[static_cast<size_t>(lane)]));
+        }
+        for (int lane = 0; lane < numLanes; ++lane) {
+            x[static_cast<size_t>(lane)] = x[static_cast<size_t>(linkedLane[static_cast<size_t>(lane)])];
+        }
+    }
+}
+
+template<typename SampleType>
+void CompressorKernel::fillLookaheadTiles(SampleType* const* lanes, int start, int tileSamples) {
+    for (int lane = 0; lane < numLanes; ++lane) {
+        float* ring = history.getWritePointer(lane);
+        const SampleType* source = lanes[lane] == nullptr ? nullptr : lanes[lane] + start;
+        for (int i = 0; i < tileSamples; ++i) {
+            // a skipped band writes silence, so nothing stale is waiting in the history when it comes back
+            ring[(historyWritePos + i) & historyMask] = source == nullptr ? 0.f : static_cast<float>(source[i]);
+        }
+
+        const int detectorRead = historyWritePos - detectorDelay[static_cast<size_t>(lane)];
+        const int audioRead = historyWritePos - lookaheadDelay;
+        for (int i = 0; i < tileSamples; ++i) {
+            inputTile[static_cast<size_t>(i)][static_cast<size_t>(lane)] = ring[(detectorRead + i) & historyMask];
+            audioTile[static_cast<size_t>(i)][static_cast<size_t>(lane)] = ring[(audioRead + i) & historyMask];
+        }
+    }
+    historyWritePos = (historyWritePos + tileSamples) & historyMask;
+}
+
+// called from every path's processTiles()
+template void CompressorKernel::fillLookaheadTiles(float* const*, int, int);
+template void CompressorKernel::fillLookaheadTiles(double* const*, int, int);
+
+float CompressorKernel::computeGain(float env, float threshold, size_t lane) const {
+    // the slope is never positive, so below the threshold the gain comes out above 1 and is clamped back to unity
+    const float over = FastMath::log2(FastMath::atLeast(env, MINIMUM_LEVEL)) - threshold;
+    return juce::jmin(1.f, FastMath::exp2(over * slope[lane]));
+}
+
+void CompressorKernel::fillThresholdTile(int tileSamples) {
+    for (size_t lane = 0; lane < static_cast<size_t>(paddedLanes); ++lane) {
+        const int rampSamples = juce::jlimit(0, tileSamples, thresholdRampRemaining[lane]);
+        float threshold = thresholdLog2[lane];
+        for (int i = 0; i < rampSamples; ++i) {
+            threshold += thresholdStep[lane];
+            thresholdTile[static_cast<size_t>(i)][lane] = threshold;
+        }
+
+        // land exactly on the target so rounding in the steps never leaves it slightly off
+        if (rampSamples > 0 && (thresholdRampRemaining[lane] -= rampSamples) == 0) {
+            threshold = thresholdTargetLog2[lane];
+        }
+        for (int i = rampSamples; i < tileSamples; ++i) {
+            thresholdTile[static_cast<size_t>(i)][lane] = threshold;
+        }
+        thresholdLog2[lane] = threshold;
+    }
+}
+
+void CompressorKernel::interpolateControlGains(size_t lane, int tileSamples) {
+    const int interval = controlInterval[lane];
+    for (int start = 0; start < tileSamples; start += interval) {
+        // a control point sits on the last sample of each interval, a short final tile gets one on its last sample
+        const int length = juce::jmin(interval, tileSamples - start);
+        const float p0 = previousControlGain[lane];
+        const float p1 = lastControlGain[lane];
+        const auto controlPoint = static_cast<size_t>(start + length - 1);
+        const float p2 = computeGain(envelopeTile[controlPoint][lane], thresholdTile[controlPoint][lane], lane);
+        const float step = 1.f / static_cast<float>(length);
+
+        if (interpolation[lane] == GainInterpolation::Linear) {
+            for (int i = 0; i < length; ++i) {
+                const float t = static_cast<float>(i + 1) * step;
+                gainTile[static_cast<size_t>(start + i)][lane] = p1 + t * (p2 - p1);
+            }
+        }
+        else {
+            // Cubic Hermite, the next control point is not known yet so the end tangent is the chord
+            const float m1 = 0.5f * (p2 - p0);
+            const float m2 = p2 - p1;
+            for (int i = 0; i < length; ++i) {
+                const float t = static_cast<float>(i + 1) * step;
+                const float t2 = t * t;
+                const float t3 = t2 * t;
+                gainTile[static_cast<size_t>(start + i)][lane] = (2.f * t3 - 3.f * t2 + 1.f) * p1
+                    + (t3 - 2.f * t2 + t) * m1
+                    + (-2.f * t3 + 3.f * t2) * p2
+                    + (t3 - t2) * m2;
+            }
+        }
+
+        previousControlGain[lane] = p1;
+        lastControlGain[lane] = p2;
+    }
+}
+
+void CompressorKernel::resetMeters() {
+    inputSumSquares.fill(0.f);
+    outputSumSquares.fill(0.f);
+    inputPeak.fill(0.f);
+    outputPeak.fill(0.f);
+    minimumGain.fill(1.f);
+    meteredSamples = 0;
+}
+
+void CompressorKernel::setSimdPath(SimdPath path) {
+    jassert(SimdDispatch::isSupported(path));
+    simdPath = path;
+}
+
+template<typename SampleType>
+void CompressorKernel::process(SampleType* const* lanes, int numSamples) {
+    jassert(numLanes > 0);
+    switch (simdPath) {
+    case SimdPath::Avx512:
+        processAvx512(lanes, numSamples);
+        break;
+    case SimdPath::Avx2:
+        processAvx2(lanes, numSamples);
+        break;
+    default:
+        processTiles<SimdPath::Baseline>(lanes, numSamples);
+        break;
+    }
+}
+
+template void CompressorKernel::process(float* const*, int);
+template void CompressorKernel::process(double* const*, int);
+
+float CompressorKernel::getGainReductionDb(int band) const {
+    jassert(juce::isPositiveAndBelow(band, numBands));
+    auto reduction = 0.f;
+    for (int chan = 0; chan < numChannels; ++chan) {
+        reduction = juce::jmin(reduction, gainReductionDb[static_cast<size_t>(band * numChannels + chan)]);
+    }
+    return reduction;
+}
+
+CompressorKernel::BandLevels CompressorKernel::getBandLevels(int band) const {
+    jassert(juce::isPositiveAndBelow(band, numBands));
+    BandLevels levels;
+    if (meteredSamples == 0 || numChannels == 0) {
+        return levels;
+    }
+
+    // the channels' powers are averaged, not their RMS levels, so a band that is loud in one channel reads as loud
+    auto inputPower = 0.f, outputPower = 0.f, totalWeight = 0.f;
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto lane = static_cast<size_t>(band * numChannels + chan);
+        inputPower += meterWeight[lane] * inputSumSquares[lane];
+        outputPower += meterWeight[lane] * outputSumSquares[lane];
+        totalWeight += meterWeight[lane];
+        levels.inputPeak = juce::jmax(levels.inputPeak, inputPeak[lane]);
+        levels.outputPeak = juce::jmax(levels.outputPeak, outputPeak[lane]);
+        levels.minimumGain = juce::jmin(levels.minimumGain, minimumGain[lane]);
+    }
+
+    if (totalWeight > 0.f) {
+        levels.inputRms = std::sqrt(inputPower / (totalWeight * static_cast<float>(meteredSamples)));
+        levels.outputRms = std::sqrt(outputPower / (totalWeight * static_cast<float>(meteredSamples)));
+    }
+    return levels;
+}
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    CompressorKernel.h
+    Created: 19 Oct 2026 12:42:45am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "SimdDispatch.h"
+
+//==============================================================================
+// Compresses every band and channel of the plugin in one pass.
+// Each band/channel pair is a "lane" (lane = band * numChannels + channel). All of the envelope state lives in
+// structure-of-arrays form so the same instructions run one sample of every lane at once, instead of running
+// a separate juce::dsp::Compressor per band.
+// The ballistics and the gain curve match juce::dsp::Compressor (peak envelope, hard knee), but the attack/release
+// choice is branch-free and the gain is computed in the log2 domain.
+struct CompressorKernel {
+    static constexpr int MaxLanes = 64; // 5 bands * 12 channels (7.1.4), padded up to whole AVX registers
+    static constexpr int RegisterLanes = 8; // lanes per AVX register, the vector loops run over whole registers only
+    static constexpr int TileSize = 16; // samples transposed into lane order at a time, also the longest control interval
+
+    // How the gain is filled in between control points when a band runs its gain computer at a control rate
+    enum class GainInterpolation {
+        Linear,
+        Cubic
+    };
+
+    // maxLookaheadSamples is the longest setLookaheadDelay() will be asked for
+    void prepare(double sampleRate, int numBands, int numChannels, int maxLookaheadSamples);
+    void reset();
+    // starts one band over from silence, for when it comes back after being skipped
+    void resetBand(int band);
+
+    // A new threshold is reached with a linear ramp (in dB) over THRESHOLD_SMOOTHING_SECONDS, the rest apply immediately
+    void setBandParameters(int band, float attackMs, float releaseMs, float thresholdDb, float ratio, bool bypassed);
+
+    // Runs the band's threshold/ratio gain computer (and its log2/exp2) only every intervalSamples samples,
+    // the gain applied in between is interpolated. intervalSamples must be a power of two no larger than TileSize,
+    // 1 evaluates every sample.
+    // The envelope itself is still tracked every sample, only the gain curve is decimated. Control points are exact, and
+    // with linear interpolation the applied gain always lies between the exact gains at the two surrounding control
+    // points, so the error on any sample is at most how far the exact gain moves within one interval, D.
+    // For input peaking at A, a fixed linear threshold T, s = 1 - 1 / ratio and the attack/release coefficients ca/cr,
+    // over K samples the envelope can grow at most by (ca^K + (1 - ca^K) * A / T) and decay at most by cr^K, so
+    //     D <= max(1 - (ca^K + (1 - ca^K) * A / T)^-s, 1 - cr^(K * s))
+    // and the difference from the per sample output is at most A * D. The cubic curve can overshoot the control points
+    // by 2/27 of the gain change across two intervals, so it is bounded by A * D * 31 / 27.
+    // The attack term dominates and is reached where the envelope jumps through the threshold. Away from that the
+    // difference is far lower, see Tests/Source/CompressorKernelTests.cpp
+    void setBandControlRate(int band, int intervalSamples, GainInterpolation interpolation);
+
+    // Lookahead. Every lane's output is delayed by delaySamples, and a band's detector runs lookaheadSamples (at most
+    // the delay) ahead of the audio its gain is applied to, so the gain is already down when a transient gets there.
+    // Every lane writes into one shared history buffer and reads it back at two points, one for the detector and one
+    // for the audio. Changing either jumps the read points, so it isn't meant to be automated
+    void setLookaheadDelay(int delaySamples);
+    void setBandLookahead(int band, int lookaheadSamples);
+    int getLookaheadDelay() const { return lookaheadDelay; }
+
+    // Channel linking. linkGroups[channel] is the lowest channel of the group it belongs to, for numChannels channels.
+    // Within each band the channels of a group all follow the loudest of them, so they get the same gain
+    void setChannelLinks(const int* linkGroups);
+    // How much each channel counts towards a band's RMS levels, numChannels of them. Every channel counts equally until set
+    void setChannelMeterWeights(const float* weights);
+
+    // lanes[band * numChannels + channel] must point at numSamples samples, processed in place.
+    // A null lane is skipped: nothing is read or written for it and its envelope is fed silence.
+    // Float and double lanes are both supported. The detector and the gain are always computed in single precision,
+    // the gain is applied to the lanes in their own precision (the lookahead history is single precision though)
+    template<typename SampleType>
+    void process(SampleType* const* lanes, int numSamples);
+
+    // which build of process() runs, a path this CPU supports. Baseline until set
+    void setSimdPath(SimdPath path);
+    SimdPath getSimdPath() const { return simdPath; }
+
+    // Starts a new metering period, levels accumulate over every process() call until the next one
+    void resetMeters();
+
+    // Levels of one band since the last resetMeters(), measured while the samples pass through the gain stage anyway.
+    // RMS is the weighted mean power of the band's channels, peaks and the minimum gain are taken from the loudest one
+    struct BandLevels {
+        float inputRms{ 0.f };
+        float outputRms{ 0.f };
+        float inputPeak{ 0.f };
+        float outputPeak{ 0.f };
+        float minimumGain{ 1.f };
+    };
+    BandLevels getBandLevels(int band) const;
+
+    // Gain reduction (<= 0 dB) the band applied on the last processed sample, loudest channel wins
+    float getGainReductionDb(int band) const;
+    // Gain reduction envelope of a single lane, in dB, on the last processed sample
+    float getLaneGainReductionDb(int lane) const { return gainReductionDb[static_cast<size_t>(lane)]; }
+
+    int getNumLanes() const { return numLanes; }
+
+    // One step of the peak envelope towards in. Attack or release is selected with a mask instead of a branch, so
+    // loops running it across lanes or bands stay vectorised
+    static MBCOMP_ALWAYS_INLINE float followEnvelope(float envelope, float in, float attackCte, float releaseCte) {
+        const float rising = static_cast<float>(in > envelope);
+        const float cte = releaseCte + rising * (attackCte - releaseCte);
+        return in + cte * (envelope - in);
+    }
+private:
+    using LaneArray = std::array<float, MaxLanes>;
+
+    double sampleRate{ 44100.0 };
+    SimdPath simdPath{ SimdPath::Baseline };
+    int numBands{ 0 };
+    int numChannels{ 0 };
+    int numLanes{ 0 };
+    int paddedLanes{ 0 }; // numLanes rounded up to whole registers, so 3 bands don't pay for 5
+
+    // per lane coefficients, written by setBandParameters()
+    alignas(32) LaneArray attackCte{};
+    alignas(32) LaneArray releaseCte{};
+    alignas(32) LaneArray thresholdLog2{};      // where the threshold is now, ramping towards thresholdTargetLog2
+    alignas(32) LaneArray thresholdTargetLog2{};
+    alignas(32) LaneArray thresholdStep{};
+    std::array<int, MaxLanes> thresholdRampRemaining{};
+    int thresholdRampSamples{ 1 };
+    alignas(32) LaneArray slope{};      // (1 / ratio) - 1, zero when the band is bypassed
+    std::array<int, MaxLanes> controlInterval{};
+    std::array<GainInterpolation, MaxLanes> interpolation{};
+    // first lane of each register holding a lane with an interval of 1, the only registers the per sample gain
+    // computer runs over
+    std::array<int, MaxLanes / RegisterLanes> everySampleRegisters{};
+    int numEverySampleRegisters{ 0 };
+
+    // per lane meters, cleared by resetMeters()
+    alignas(32) LaneArray inputSumSquares{};
+    alignas(32) LaneArray outputSumSquares{};
+    alignas(32) LaneArray inputPeak{};
+    alignas(32) LaneArray outputPeak{};
+    alignas(32) LaneArray minimumGain{};
+    int meteredSamples{ 0 };
+
+    // lookahead, [lane][sample] rings of a power of two size in one allocation
+    juce::AudioBuffer<float> history;
+    int historyMask{ 0 };
+    int historyWritePos{ 0 };
+    int lookaheadDelay{ 0 };
+    std::array<int, MaxLanes> laneLookahead{};
+    std::array<int, MaxLanes> detectorDelay{}; // lookaheadDelay minus the lane's lookahead
+
+    // the lane leading each lane's link group, itself when it isn't linked
+    std::array<int, MaxLanes> linkedLane{};
+    bool anyLanesLinked{ false };
+    alignas(32) LaneArray meterWeight{};
+
+    // per lane state
+    alignas(32) LaneArray envelope{};
+    alignas(32) LaneArray gainReductionDb{};
+    alignas(32) LaneArray lastControlGain{};     // gain at the most recent control point
+    alignas(32) LaneArray previousControlGain{}; // and the one before it, for cubic interpolation
+
+    // scratch, [sample][lane]
+    alignas(32) std::array<LaneArray, TileSize> inputTile{}; // what the detector sees
+    alignas(32) std::array<LaneArray, TileSize> audioTile{}; // what the gain is applied to, when that is delayed
+    alignas(32) std::array<LaneArray, TileSize> envelopeTile{};
+    alignas(32) std::array<LaneArray, TileSize> gainTile{};
+    alignas(32) std::array<LaneArray, TileSize> thresholdTile{};
+
+    // The body of process(), in CompressorKernelBody.h, and one wrapper per SimdPath in that path's own file.
+    // The path is only there so each file's copy of the body is a symbol of its own
+    template<SimdPath Path, typename SampleType>
+    MBCOMP_ALWAYS_INLINE void processTiles(SampleType* const* lanes, int numSamples);
+    template<typename SampleType>
+    MBCOMP_TARGET_AVX2 void processAvx2(SampleType* const* lanes, int numSamples);
+    template<typename SampleType>
+    MBCOMP_TARGET_AVX512 void processAvx512(SampleType* const* lanes, int numSamples);
+
+    float calculateCte(float timeMs) const;
+    void fillThresholdTile(int tileSamples);
+    float computeGain(float env, float threshold, size_t lane) const;
+    void interpolateControlGains(size_t lane, int tileSamples);
+    template<typename SampleType>
+    void fillLookaheadTiles(SampleType* const* lanes, int start, int tileSamples);
+    void updateDetectorDelays();
+    void updateEverySampleRegisters();
+    void linkDetectors(int tileSamples);
+};
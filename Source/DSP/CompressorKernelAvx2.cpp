@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    CompressorKernelAvx2.cpp
+    Created: 19 Oct 2026 2:41:50am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "CompressorKernelBody.h"
+
+template<typename SampleType>
+MBCOMP_TARGET_AVX2 void CompressorKernel::processAvx2(SampleType* const* lanes, int numSamples) {
+    processTiles<SimdPath::Avx2>(lanes, numSamples);
+}
+
+template void CompressorKernel::processAvx2(float* const*, int);
+template void CompressorKernel::processAvx2(double* const*, int);
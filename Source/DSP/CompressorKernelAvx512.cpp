@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    CompressorKernelAvx512.cpp
+    Created: 19 Oct 2026 2:41:50am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "CompressorKernelBody.h"
+
+template<typename SampleType>
+MBCOMP_TARGET_AVX512 void CompressorKernel::processAvx512(SampleType* const* lanes, int numSamples) {
+    processTiles<SimdPath::Avx512>(lanes, numSamples);
+}
+
+template void CompressorKernel::processAvx512(float* const*, int);
+template void CompressorKernel::processAvx512(double* const*, int);
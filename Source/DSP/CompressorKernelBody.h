@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    CompressorKernelBody.h
+    Created: 19 Oct 2026 2:41:50am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "CompressorKernel.h"
+#include "FastMath.h"
+#include "../Constants.h"
+
+//==============================================================================
+// The body of CompressorKernel::process(), included by CompressorKernel.cpp and by the file of every other SimdPath
+// so each compiles it for its own instruction set
+template<SimdPath Path, typename SampleType>
+void CompressorKernel::processTiles(SampleType* const* lanes, int numSamples) {
+    meteredSamples += numSamples;
+
+    for (int start = 0; start < numSamples; start += TileSize) {
+        const int tileSamples = juce::jmin(TileSize, numSamples - start);
+
+        // transpose into [sample][lane] order so one sample of every lane sits in one register
+        if (lookaheadDelay > 0) {
+            fillLookaheadTiles(lanes, start, tileSamples);
+        }
+        else {
+            for (int lane = 0; lane < numLanes; ++lane) {
+                if (lanes[lane] == nullptr) {
+                    // a skipped band is fed silence, so its envelope just releases
+                    for (int i = 0; i < tileSamples; ++i) {
+                        inputTile[i][lane] = 0.f;
+                    }
+                    continue;
+                }
+
+                const SampleType* source = lanes[lane] + start;
+                for (int i = 0; i < tileSamples; ++i) {
+                    inputTile[i][lane] = static_cast<float>(source[i]);
+                }
+            }
+        }
+
+        if (anyLanesLinked) {
+            linkDetectors(tileSamples);
+        }
+
+        // Ballistics. The recursion runs along time, so the vectorisation is across lanes
+        for (int i = 0; i < tileSamples; ++i) {
+            const auto& x = inputTile[i];
+            auto& env = envelopeTile[i];
+            for (int lane = 0; lane < paddedLanes; ++lane) {
+                envelope[lane] = followEnvelope(envelope[lane], std::abs(x[lane]), attackCte[lane], releaseCte[lane]);
+                env[lane] = envelope[lane];
+            }
+        }
+
+        // threshold changes are smoothed per sample, so automating it never steps the gain
+        fillThresholdTile(tileSamples);
+
+        // Gain computer, in log2 space: above the threshold gain = (env / threshold) ^ ((1 / ratio) - 1).
+        // The polynomial log2 and exp2 keep this loop vectorised, see computeGain() for the clamp.
+        // Only the registers holding a band that runs every sample are computed here, bands at a control rate get
+        // their gains from interpolateControlGains() below
+        for (int reg = 0; reg < numEverySampleRegisters; ++reg) {
+            const int firstLane = everySampleRegisters[static_cast<size_t>(reg)];
+            for (int i = 0; i < tileSamples; ++i) {
+                const auto& env = envelopeTile[i];
+                const auto& thr = thresholdTile[i];
+                auto& g = gainTile[i];
+                for (int lane = firstLane; lane < firstLane + RegisterLanes; ++lane) {
+                    const float over = FastMath::log2(FastMath::atLeast(env[lane], MINIMUM_LEVEL)) - thr[lane];
+                    g[lane] = juce::jmin(1.f, FastMath::exp2(over * slope[lane]));
+                }
+            }
+        }
+
+        for (size_t lane = 0; lane < static_cast<size_t>(numLanes); ++lane) {
+            if (lanes[lane] == nullptr) {
+                continue;
+            }
+            if (controlInterval[lane] > 1) {
+                interpolateControlGains(lane, tileSamples);
+            }
+            else {
+                // keeps a later switch to a control rate from starting off a stale gain
+                previousControlGain[lane] = lastControlGain[lane] = gainTile[static_cast<size_t>(tileSamples - 1)][lane];
+            }
+        }
+
+        // apply the gain, metering on the way out so the GUI never needs another pass over the band.
+        // Without lookahead the lanes still hold the audio, in their own precision
+        const auto isDelayed = lookaheadDelay > 0;
+        for (size_t lane = 0; lane < static_cast<size_t>(numLanes); ++lane) {
+            if (lanes[lane] == nullptr) {
+                continue;
+            }
+
+            SampleType* dest = lanes[lane] + start;
+            float inSquares = 0.f, outSquares = 0.f;
+            float inPeak = inputPeak[lane], outPeak = outputPeak[lane], minGain = minimumGain[lane];
+            for (int i = 0; i < tileSamples; ++i) {
+                const SampleType sample = isDelayed ? static_cast<SampleType>(audioTile[static_cast<size_t>(i)][lane]) : dest[i];
+                const float gain = gainTile[static_cast<size_t>(i)][lane];
+                const SampleType result = sample * static_cast<SampleType>(gain);
+                dest[i] = result;
+                const auto in = static_cast<float>(sample);
+                const auto out = static_cast<float>(result);
+                inSquares += in * in;
+                outSquares += out * out;
+                inPeak = juce::jmax(inPeak, std::abs(in));
+                outPeak = juce::jmax(outPeak, std::abs(out));
+                minGain = juce::jmin(minGain, gain);
+            }
+            inputSumSquares[lane] += inSquares;
+            outputSumSquares[lane] += outSquares;
+            inputPeak[lane] = inPeak;
+            outputPeak[lane] = outPeak;
+            minimumGain[lane] = minGain;
+        }
+    }
+
+    // only the end of the block is exposed, so convert it once here rather than per sample
+    for (int lane = 0; lane < paddedLanes; ++lane) {
+        const float over = juce::jmax(0.f, FastMath::log2(FastMath::atLeast(envelope[lane], MINIMUM_LEVEL)) - thresholdLog2[lane]);
+        gainReductionDb[lane] = FastMath::DB_PER_LOG2 * over * slope[lane];
+    }
+}
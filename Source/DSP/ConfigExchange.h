@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    ConfigExchange.h
+    Created: 19 Oct 2026 1:16:13am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+// Hands immutable DSP configurations, built on the BackgroundBuilder thread, over to the audio thread.
+// The builder publishes a new configuration with an atomic exchange, the audio thread picks it up with another one and
+// keeps the configuration it replaces as the outgoing one while it crossfades between the two. Once it is done with it
+// the outgoing configuration goes back through a fifo and the builder frees it, so the audio thread never waits on a
+// lock and never allocates or frees a configuration.
+// A configuration published before the audio thread picked up the previous one simply replaces it.
+template<typename Config>
+struct ConfigExchange {
+    ~ConfigExchange() {
+        clear();
+    }
+
+    // message thread, while neither the audio thread nor the builder are running
+    void reset(std::unique_ptr<Config> config) {
+        clear();
+        current = config.release();
+    }
+
+    // builder thread
+    void publish(std::unique_ptr<Config> config) {
+        delete pending.exchange(config.release(), std::memory_order_acq_rel);
+    }
+
+    // builder thread, frees everything the audio thread is done with
+    void collectGarbage() {
+        juce::AbstractFifo::ScopedRead read = retiredFifo.read(retiredFifo.getNumReady());
+        read.forEach([this](int index) {
+            delete retired[static_cast<size_t>(index)];
+            retired[static_cast<size_t>(index)] = nullptr;
+        });
+    }
+
+    // Audio thread. Makes the newest published configuration current, the one it replaces is outgoing until
+    // retireOutgoing(). Returns false when there's nothing new, or while the last swap hasn't been retired yet
+    bool swapIfPublished() {
+        if (outgoing != nullptr || !flushRetiring() || pending.load(std::memory_order_relaxed) == nullptr) {
+            return false;
+        }
+        auto* next = pending.exchange(nullptr, std::memory_order_acq_rel);
+        if (next == nullptr) {
+            return false;
+        }
+        outgoing = current;
+        current = next;
+        return true;
+    }
+
+    // audio thread, once nothing reads the outgoing configuration any more
+    void retireOutgoing() {
+        jassert(retiring == nullptr);
+        retiring = outgoing;
+        outgoing = nullptr;
+        flushRetiring();
+    }
+
+    const Config* getCurrent() const { return current; }
+    const Config* getOutgoing() const { return outgoing; }
+private:
+    static constexpr int RetiredCapacity = 8;
+
+    std::atomic<Config*> pending{ nullptr };
+    Config* current{ nullptr };
+    Config* outgoing{ nullptr };
+    // retired but not yet in the fifo, it only fills up when the builder falls behind
+    Config* retiring{ nullptr };
+
+    juce::AbstractFifo retiredFifo{ RetiredCapacity };
+    std::array<Config*, RetiredCapacity> retired{};
+
+    bool flushRetiring() {
+        if (retiring == nullptr) {
+            return true;
+        }
+        juce::AbstractFifo::ScopedWrite write = retiredFifo.write(1);
+        if (write.blockSize1 > 0) {
+            retired[static_cast<size_t>(write.startIndex1)] = retiring;
+            retiring = nullptr;
+            return true;
+        }
+        return false;
+    }
+
+    void clear() {
+        collectGarbage();
+        delete pending.exchange(nullptr);
+        delete current;
+        delete outgoing;
+        delete retiring;
+        current = outgoing = retiring = nullptr;
+    }
+};
@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+    CrossoverFilter.h
+    Created: 19 Oct 2026 1:07:41am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+// Linkwitz-Riley slopes, 12, 24 and 48 dB/oct
+enum class CrossoverSlope {
+    LR2,
+    LR4,
+    LR8
+};
+
+//==============================================================================
+// The sections of one Linkwitz-Riley filter order, with everything fixed at compile time.
+// An LR filter of order N is a Butterworth filter of order N / 2 run twice: LR2 is built from one pole sections,
+// LR4 and LR8 from one and two state variable sections (the same topology as juce::dsp::LinkwitzRileyFilter).
+// The high output of a split is the all pass of the first Butterworth half minus the low output, so the two outputs
+// always sum to that all pass. For LR2 this is the polarity inverted high pass, which is what makes LR2 sum flat.
+// A channel's state is NumStates contiguous values, each function loads it once, runs the unrolled cascade over the
+// block and stores it back.
+template<typename SampleType, int Order>
+struct LinkwitzRileySections {
+    static_assert(Order == 2 || Order == 4 || Order == 8, "only LR2, LR4 and LR8 are supported");
+
+    static constexpr int NumSections = Order == 2 ? 1 : Order / 4; // per Butterworth half
+    static constexpr int StatesPerSection = Order == 2 ? 1 : 2;
+    // both halves of the low pass, plus the all pass of every section past the first
+    static constexpr int NumStates = (2 * NumSections + NumSections - 1) * StatesPerSection;
+
+    using State = std::array<SampleType, static_cast<size_t>(NumStates)>;
+
+    struct Coefficients {
+        std::array<SampleType, static_cast<size_t>(NumSections)> g{};
+        std::array<SampleType, static_cast<size_t>(NumSections)> k{}; // damping, 1 / Q
+        std::array<SampleType, static_cast<size_t>(NumSections)> h{};
+    };
+
+    static Coefficients makeCoefficients(double cutoff, double sampleRate) {
+        Coefficients c;
+        auto g = std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+        for (int i = 0; i < NumSections; ++i) {
+            // Butterworth pole pairs, 2 * cos((2i + 1) * pi / (2n)) for a filter of order n = Order / 2
+            auto k = Order == 2 ? 0.0 : 2.0 * std::cos((2.0 * i + 1.0) * juce::MathConstants<double>::pi / (Order));
+            c.g[static_cast<size_t>(i)] = static_cast<SampleType>(Order == 2 ? g / (1.0 + g) : g);
+            c.k[static_cast<size_t>(i)] = static_cast<SampleType>(k);
+            c.h[static_cast<size_t>(i)] = static_cast<SampleType>(1.0 / (1.0 + k * g + g * g));
+        }
+        return c;
+    }
+
+    // slowest decay of any pole, in radians per second
+    static double getSlowestDecayRate(double cutoff) {
+        auto omega = juce::MathConstants<double>::twoPi * cutoff;
+        return Order == 2 ? omega : omega * std::cos((NumSections * 2.0 - 1.0) * juce::MathConstants<double>::pi / Order);
+    }
+
+    static void split(const Coefficients& c, SampleType* state, const SampleType* input, SampleType* low, SampleType* high, int numSamples) {
+        auto s = load(state);
+        for (int i = 0; i < numSamples; ++i) {
+            SampleType allpass;
+            const auto lp = cascade(c, s, input[i], &allpass);
+            low[i] = lp;
+            high[i] = allpass - lp;
+        }
+        store(s, state);
+    }
+
+    static void lowpass(const Coefficients& c, SampleType* state, SampleType* samples, int numSamples) {
+        auto s = load(state);
+        for (int i = 0; i < numSamples; ++i) {
+            samples[i] = cascade(c, s, samples[i], nullptr);
+        }
+        store(s, state);
+    }
+
+    // the all pass the split's outputs sum to, for the bands that don't go through this crossover's split
+    static void allpass(const Coefficients& c, SampleType* state, SampleType* samples, int numSamples) {
+        auto s = load(state);
+        for (int i = 0; i < numSamples; ++i) {
+            auto x = samples[i];
+            if constexpr (Order == 2) {
+                x = SampleType(2) * onePole(c.g[0], s[0], x) - x;
+            }
+            else {
+                for (size_t section = 0; section < static_cast<size_t>(NumSections); ++section) {
+                    x = svfAllpass(c, section, s[2 * section], s[2 * section + 1], x);
+                }
+            }
+            samples[i] = x;
+        }
+        store(s, state);
+    }
+
+private:
+    static SampleType onePole(SampleType g, SampleType& s, SampleType x) {
+        auto v = (x - s) * g;
+        auto lp = v + s;
+        s = lp + v;
+        return lp;
+    }
+
+    static SampleType svf(const Coefficients& c, size_t section, SampleType& s1, SampleType& s2, SampleType x, SampleType& bp, SampleType& hp) {
+        const auto g = c.g[section];
+        hp = (x - (c.k[section] + g) * s1 - s2) * c.h[section];
+        bp = g * hp + s1;
+        s1 = g * hp + bp;
+        auto lp = g * bp + s2;
+        s2 = g * bp + lp;
+        return lp;
+    }
+
+    static SampleType svfAllpass(const Coefficients& c, size_t section, SampleType& s1, SampleType& s2, SampleType x) {
+        SampleType bp, hp;
+        auto lp = svf(c, section, s1, s2, x, bp, hp);
+        return lp - c.k[section] * bp + hp;
+    }
+
+    // Both Butterworth halves in series. When allpass isn't null it also gets the first half's all pass, which
+    // comes for free from the first section, and for LR8 needs one more section for the second pole pair
+    static SampleType cascade(const Coefficients& c, State& s, SampleType x, SampleType* allpass) {
+        if constexpr (Order == 2) {
+            auto lp = onePole(c.g[0], s[0], x);
+            if (allpass != nullptr) {
+                *allpass = SampleType(2) * lp - x;
+            }
+            return onePole(c.g[0], s[1], lp);
+        }
+        else {
+            SampleType bp, hp;
+            auto y = svf(c, 0, s[0], s[1], x, bp, hp);
+            auto ap = y - c.k[0] * bp + hp;
+            for (size_t section = 1; section < static_cast<size_t>(NumSections); ++section) {
+                y = svf(c, section, s[2 * section], s[2 * section + 1], y, bp, hp);
+            }
+            for (size_t section = 0; section < static_cast<size_t>(NumSections); ++section) {
+                y = svf(c, section, s[2 * (NumSections + section)], s[2 * (NumSections + section) + 1], y, bp, hp);
+            }
+            if (allpass != nullptr) {
+                for (size_t section = 1; section < static_cast<size_t>(NumSections); ++section) {
+                    ap = svfAllpass(c, section, s[2 * (2 * NumSections + section - 1)], s[2 * (2 * NumSections + section - 1) + 1], ap);
+                }
+                *allpass = ap;
+            }
+            return y;
+        }
+    }
+
+    static State load(const SampleType* state) {
+        State s{};
+        std::copy(state, state + NumStates, s.begin());
+        return s;
+    }
+
+    static void store(State& s, SampleType* state) {
+        for (auto& value : s) {
+            juce::dsp::util::snapToZero(value);
+        }
+        std::copy(s.begin(), s.end(), state);
+    }
+};
+
+//==============================================================================
+// One crossover point whose slope can be changed at runtime.
+// Every slope is compiled as its own LinkwitzRileySections, the choice is made once per block rather than per sample.
+// A filter is used in a single role: as a split, a low pass or an all pass.
+template<typename SampleType>
+struct CrossoverFilter {
+    void prepare(const juce::dsp::ProcessSpec& spec) {
+        sampleRate = spec.sampleRate;
+        state.assign(spec.numChannels, {});
+        update();
+    }
+
+    void reset() {
+        for (auto& channelState : state) {
+            channelState.fill(SampleType(0));
+        }
+    }
+
+    void setCutoffFrequency(SampleType newCutoff) {
+        if (newCutoff != cutoff) {
+            cutoff = newCutoff;
+            update();
+        }
+    }
+
+    // the state means something else at another order, so a change of slope starts the filter over from silence
+    void setSlope(CrossoverSlope newSlope) {
+        if (newSlope != slope) {
+            slope = newSlope;
+            reset();
+            update();
+        }
+    }
+    CrossoverSlope getSlope() const { return slope; }
+
+    void split(int channel, const SampleType* input, SampleType* low, SampleType* high, int numSamples) {
+        dispatch(channel, [&](const auto& sections, const auto& c, SampleType* s) { sections.split(c, s, input, low, high, numSamples); });
+    }
+
+    void lowpass(int channel, SampleType* samples, int numSamples) {
+        dispatch(channel, [&](const auto& sections, const auto& c, SampleType* s) { sections.lowpass(c, s, samples, numSamples); });
+    }
+
+    void allpass(int channel, SampleType* samples, int numSamples) {
+        dispatch(channel, [&](const auto& sections, const auto& c, SampleType* s) { sections.allpass(c, s, samples, numSamples); });
+    }
+
+    // every channel in place
+    void lowpass(juce::AudioBuffer<SampleType>& buffer) {
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan) {
+            lowpass(chan, buffer.getWritePointer(chan), buffer.getNumSamples());
+        }
+    }
+
+    void allpass(juce::AudioBuffer<SampleType>& buffer) {
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan) {
+            allpass(chan, buffer.getWritePointer(chan), buffer.getNumSamples());
+        }
+    }
+
+    // how quickly the filter's ringing dies away, in radians per second
+    static double getSlowestDecayRate(CrossoverSlope slope, double cutoff) {
+        switch (slope) {
+        case CrossoverSlope::LR2:
+            return LR2::getSlowestDecayRate(cutoff);
+        case CrossoverSlope::LR8:
+            return LR8::getSlowestDecayRate(cutoff);
+        default:
+            return LR4::getSlowestDecayRate(cutoff);
+        }
+    }
+private:
+    using LR2 = LinkwitzRileySections<SampleType, 2>;
+    using LR4 = LinkwitzRileySections<SampleType, 4>;
+    using LR8 = LinkwitzRileySections<SampleType, 8>;
+
+    static constexpr size_t MaxStates = static_cast<size_t>(LR8::NumStates);
+    using ChannelState = std::array<SampleType, MaxStates>;
+
+    double sampleRate{ 44100.0 };
+    SampleType cutoff{ SampleType(1000) };
+    CrossoverSlope slope{ CrossoverSlope::LR4 };
+
+    typename LR2::Coefficients lr2;
+    typename LR4::Coefficients lr4;
+    typename LR8::Coefficients lr8;
+
+    // [channel][state], one contiguous block big enough for the steepest slope
+    std::vector<ChannelState> state;
+
+    void update() {
+        switch (slope) {
+        case CrossoverSlope::LR2:
+            lr2 = LR2::makeCoefficients(cutoff, sampleRate);
+            break;
+        case CrossoverSlope::LR4:
+            lr4 = LR4::makeCoefficients(cutoff, sampleRate);
+            break;
+        case CrossoverSlope::LR8:
+            lr8 = LR8::makeCoefficients(cutoff, sampleRate);
+            break;
+        }
+    }
+
+    template<typename Fn>
+    void dispatch(int channel, Fn&& fn) {
+        auto* channelState = state[static_cast<size_t>(channel)].data();
+        switch (slope) {
+        case CrossoverSlope::LR2:
+            fn(LR2{}, lr2, channelState);
+            break;
+        case CrossoverSlope::LR4:
+            fn(LR4{}, lr4, channelState);
+            break;
+        case CrossoverSlope::LR8:
+            fn(LR8{}, lr8, channelState);
+            break;
+        }
+    }
+};
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    CrossoverTree.h
+    Created: 19 Oct 2026 1:03:17am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "CrossoverFilter.h"
+
+//==============================================================================
+// Splits a signal into NumBands Linkwitz-Riley bands that sum back to an all pass.
+// The bands are split as a balanced binary tree built at compile time: each node splits its range of bands in half at
+// one crossover, and each half is run through the all passes of the crossovers on the other half, so every band
+// passes through every crossover exactly once.
+// A split produces both of its outputs from one filter, and splitting down the middle needs fewer all passes than
+// splitting one band off at a time: 2 bands use 1 split, 3 use 2 splits + 1 all pass, 4 use 3 + 2 and 5 use 4 + 4.
+template<typename SampleType, int First, int Count>
+struct CrossoverNode {
+    using Filter = CrossoverFilter<SampleType>;
+    using Buffer = juce::AudioBuffer<SampleType>;
+
+    static constexpr int LowCount = Count / 2;
+    static constexpr int HighCount = Count - LowCount;
+    static constexpr int Mid = First + LowCount; // first band of the high half
+    static constexpr int SplitIndex = Mid - 1;  // crossover between band Mid - 1 and band Mid
+
+    using LowNode = CrossoverNode<SampleType, First, LowCount>;
+    using HighNode = CrossoverNode<SampleType, Mid, HighCount>;
+
+    static constexpr int NumAllpasses = (HighCount - 1) + (LowCount - 1) + LowNode::NumAllpasses + HighNode::NumAllpasses;
+
+    void prepare(const juce::dsp::ProcessSpec& spec) {
+        split.prepare(spec);
+        for (auto& allpass : lowCompensation) {
+            allpass.prepare(spec);
+        }
+        for (auto& allpass : highCompensation) {
+            allpass.prepare(spec);
+        }
+        low.prepare(spec);
+        high.prepare(spec);
+        isWarm = lowCompensationIsWarm = highCompensationIsWarm = true;
+    }
+
+    void reset() {
+        split.reset();
+        for (auto& allpass : lowCompensation) {
+            allpass.reset();
+        }
+        for (auto& allpass : highCompensation) {
+            allpass.reset();
+        }
+        low.reset();
+        high.reset();
+    }
+
+    void setCutoffFrequency(int index, SampleType frequency) {
+        forEachFilter(index, [frequency](Filter& filter) { filter.setCutoffFrequency(frequency); });
+    }
+
+    void setSlope(int index, CrossoverSlope slope) {
+        forEachFilter(index, [slope](Filter& filter) { filter.setSlope(slope); });
+    }
+
+    // every filter in the subtree that belongs to crossover index
+    template<typename Fn>
+    void forEachFilter(int index, Fn&& fn) {
+        // only the crossovers between this node's own bands concern it
+        if (index < First || index > First + Count - 2) {
+            return;
+        }
+
+        if (index == SplitIndex) {
+            fn(split);
+        }
+        // the low half is aligned to the crossovers inside the high half, and the other way round
+        else if (index >= Mid) {
+            fn(lowCompensation[static_cast<size_t>(index - Mid)]);
+        }
+        else {
+            fn(highCompensation[static_cast<size_t>(index - First)]);
+        }
+        low.forEachFilter(index, fn);
+        high.forEachFilter(index, fn);
+    }
+
+    // Works out which filters run this block and clears the ones that sat idle, they have state from whenever they
+    // last ran. Called once per block before processChannel()
+    template<size_t NumBands>
+    void prepareBlock(const std::array<bool, NumBands>& bandNeeded) {
+        lowNeeded = std::any_of(bandNeeded.begin() + First, bandNeeded.begin() + Mid, [](bool needed) { return needed; });
+        highNeeded = std::any_of(bandNeeded.begin() + Mid, bandNeeded.begin() + First + Count, [](bool needed) { return needed; });
+
+        if (!lowNeeded && !highNeeded) {
+            isWarm = false;
+            return;
+        }
+        if (!isWarm) {
+            reset();
+            isWarm = true;
+        }
+
+        auto warmAllpasses = [](auto& allpasses, bool& allpassesAreWarm, bool needed) {
+            if (needed && !allpassesAreWarm) {
+                for (auto& allpass : allpasses) {
+                    allpass.reset();
+                }
+            }
+            allpassesAreWarm = needed;
+        };
+        warmAllpasses(lowCompensation, lowCompensationIsWarm, lowNeeded);
+        warmAllpasses(highCompensation, highCompensationIsWarm, highNeeded);
+
+        low.prepareBlock(bandNeeded);
+        high.prepareBlock(bandNeeded);
+    }
+
+    // One channel of the block, bands[band][channel]. Every channel only touches its own samples and filter state,
+    // so different channels can be processed at the same time
+    template<size_t NumBands>
+    void processChannel(const std::array<SampleType* const*, NumBands>& bands, int chan, int numSamples) {
+        if (!lowNeeded && !highNeeded) {
+            return;
+        }
+
+        // the node's input is in its first band's buffer, the split leaves the low half there and the high half in Mid's
+        auto* lowSamples = bands[First][chan];
+        auto* highSamples = bands[Mid][chan];
+        split.split(chan, lowSamples, lowSamples, highSamples, numSamples);
+
+        if (lowNeeded) {
+            for (auto& allpass : lowCompensation) {
+                allpass.allpass(chan, lowSamples, numSamples);
+            }
+        }
+        if (highNeeded) {
+            for (auto& allpass : highCompensation) {
+                allpass.allpass(chan, highSamples, numSamples);
+            }
+        }
+
+        low.processChannel(bands, chan, numSamples);
+        high.processChannel(bands, chan, numSamples);
+    }
+
+private:
+    Filter split;
+    std::array<Filter, static_cast<size_t>(HighCount - 1)> lowCompensation;
+    std::array<Filter, static_cast<size_t>(LowCount - 1)> highCompensation;
+    LowNode low;
+    HighNode high;
+    bool isWarm{ true };
+    bool lowCompensationIsWarm{ true };
+    bool highCompensationIsWarm{ true };
+    bool lowNeeded{ false }; // this block, see prepareBlock()
+    bool highNeeded{ false };
+};
+
+// a single band is a leaf, there is nothing left to split
+template<typename SampleType, int First>
+struct CrossoverNode<SampleType, First, 1> {
+    static constexpr int NumAllpasses = 0;
+
+    void prepare(const juce::dsp::ProcessSpec&) {}
+    void reset() {}
+    void setCutoffFrequency(int, SampleType) {}
+    void setSlope(int, CrossoverSlope) {}
+    template<typename Fn>
+    void forEachFilter(int, Fn&&) {}
+
+    template<size_t NumBands>
+    void prepareBlock(const std::array<bool, NumBands>&) {}
+    template<size_t NumBands>
+    void processChannel(const std::array<SampleType* const*, NumBands>&, int, int) {}
+};
+
+template<typename SampleType, int NumBands>
+struct CrossoverTree {
+    static_assert(NumBands >= 2, "a crossover needs at least two bands");
+    static constexpr int NumCrossovers = NumBands - 1;
+    static constexpr int NumAllpasses = CrossoverNode<SampleType, 0, NumBands>::NumAllpasses;
+
+    void prepare(const juce::dsp::ProcessSpec& spec) { root.prepare(spec); }
+    void reset() { root.reset(); }
+
+    // index 0 is the lowest crossover
+    void setCutoffFrequency(int index, SampleType frequency) {
+        jassert(juce::isPositiveAndBelow(index, NumCrossovers));
+        root.setCutoffFrequency(index, frequency);
+    }
+
+    void setSlope(int index, CrossoverSlope slope) {
+        jassert(juce::isPositiveAndBelow(index, NumCrossovers));
+        root.setSlope(index, slope);
+    }
+
+    // bands[0] holds the input on entry, every band buffer must already be the same size as it.
+    // Filters that only feed bands that aren't needed are skipped, and reset once they are needed again
+    void process(std::array<juce::AudioBuffer<SampleType>, NumBands>& bands, const std::array<bool, NumBands>& bandNeeded) {
+        prepareBlock(bandNeeded);
+        std::array<SampleType* const*, NumBands> channels{};
+        for (size_t band = 0; band < bands.size(); ++band) {
+            channels[band] = bands[band].getArrayOfWritePointers();
+        }
+        for (int chan = 0; chan < bands[0].getNumChannels(); ++chan) {
+            processChannel(channels, chan, bands[0].getNumSamples());
+        }
+    }
+
+    // The same as process() split in two, so the channels can be shared out between threads: prepareBlock() once,
+    // then processChannel() for every channel, bands[band][channel] pointing at the band buffers' samples
+    void prepareBlock(const std::array<bool, NumBands>& bandNeeded) {
+        root.prepareBlock(bandNeeded);
+    }
+
+    void processChannel(const std::array<SampleType* const*, NumBands>& bands, int chan, int numSamples) {
+        root.processChannel(bands, chan, numSamples);
+    }
+private:
+    CrossoverNode<SampleType, 0, NumBands> root;
+};
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 19 Oct 2026 1:47:34am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+#include <cstring>
+
+//==============================================================================
+// Polynomial log2 and exp2 for the hot loops, and the decibel and log frequency conversions built on them.
+// Unlike the std:: versions they inline to a handful of multiplies, adds and integer ops with no branches, so a loop
+// over an array of them vectorises the same way the rest of the kernel does.
+// Error bounds, measured over the whole normal float range:
+//     log2               absolute error below 1.2e-5 (the fit alone is 7.4e-6)
+//     exp2               relative error below 2.5e-7 (the fit alone is 1.0e-7), |x| below 2^22, the exponent clamped to [-126, 126]
+//     gainToDecibels     absolute error below 1.1e-4 dB
+//     decibelsToGain     relative error below 1e-6, under 1e-5 dB
+//     LogFrequencyMapper absolute error below 1e-6 of the full width, 20 Hz to 20 kHz
+// log2 and exp2 take normal, finite inputs only. The decibel conversions clamp to a floor themselves
+namespace FastMath {
+    // 20 * log10(2), converts a log2 gain into decibels
+    constexpr float DB_PER_LOG2 = 6.02059991f;
+
+    inline std::int32_t toBits(float x) {
+        std::int32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+
+    inline float fromBits(std::int32_t bits) {
+        float x;
+        std::memcpy(&x, &bits, sizeof(x));
+        return x;
+    }
+
+    // x = 2^e * m with m in [1, 2), and log2(m) = t * p(t) with t = m - 1 so it is exactly 0 at 1.
+    // Degree 5 Chebyshev fit of log2(1 + t) / t on [0, 1)
+    inline float log2(float x) {
+        const auto bits = toBits(x);
+        const auto exponent = static_cast<float>((bits >> 23) - 127);
+        const auto t = fromBits((bits & 0x007fffff) | 0x3f800000) - 1.f;
+        auto p = -0.0338220460f;
+        p = p * t + 0.144471096f;
+        p = p * t - 0.301638010f;
+        p = p * t + 0.468658879f;
+        p = p * t - 0.720358773f;
+        p = p * t + 1.44268147f;
+        return exponent + t * p;
+    }
+
+    // 2^x = 2^i * 2^f with i = round(x) and f in [-0.5, 0.5]. Degree 5 Chebyshev fit of 2^f on [-0.5, 0.5].
+    // Adding 1.5 * 2^23 leaves round(x) in the low mantissa bits, and the exponent is clamped as an integer:
+    // without -ffast-math GCC won't vectorise a float clamp feeding more float maths
+    inline float exp2(float x) {
+        constexpr float RoundingShift = 12582912.f;
+        const auto shifted = x + RoundingShift;
+        const auto whole = juce::jmin(juce::jmax(toBits(shifted) - toBits(RoundingShift), -126), 126);
+        const auto f = x - (shifted - RoundingShift);
+        auto p = 0.00133908634f;
+        p = p * f + 0.00967603192f;
+        p = p * f + 0.0555035711f;
+        p = p * f + 0.240221075f;
+        p = p * f + 0.693147188f;
+        p = p * f + 1.00000008f;
+        return fromBits(toBits(p) + whole * (1 << 23));
+    }
+
+    // juce::jmax(x, minimum) for a positive minimum, compared as bits: positive floats order the same as their bit
+    // patterns and everything negative falls below. Unlike the float comparison it still vectorises without -ffast-math
+    // when more float maths follows, and zero, negative and denormal x all come out as minimum
+    inline float atLeast(float x, float minimum) {
+        jassert(minimum > 0.f);
+        return fromBits(juce::jmax(toBits(x), toBits(minimum)));
+    }
+
+    // keeps log2() on normal floats, -740 dB is below any minusInfinityDb in use
+    constexpr float MINIMUM_GAIN = 1.0e-37f;
+
+    // same results as juce::Decibels, to the bounds above
+    inline float gainToDecibels(float gain, float minusInfinityDb = -100.f) {
+        return juce::jmax(minusInfinityDb, DB_PER_LOG2 * log2(atLeast(gain, MINIMUM_GAIN)));
+    }
+
+    inline float decibelsToGain(float decibels, float minusInfinityDb = -100.f) {
+        return decibels > minusInfinityDb ? exp2(decibels / DB_PER_LOG2) : 0.f;
+    }
+
+    // in place is fine
+    inline void gainsToDecibels(const float* gains, float* decibels, int numValues, float minusInfinityDb = -100.f) {
+        for (int i = 0; i < numValues; ++i) {
+            decibels[i] = gainToDecibels(gains[i], minusInfinityDb);
+        }
+    }
+
+    //==============================================================================
+    // juce::mapFromLog10() for a fixed range: 0 at minFrequency, 1 at maxFrequency, log spaced in between.
+    // The logs of the range are taken once, so each frequency costs one log2
+    struct LogFrequencyMapper {
+        LogFrequencyMapper(float minFrequency, float maxFrequency) :
+            offset(std::log2(minFrequency)),
+            scale(1.f / (std::log2(maxFrequency) - std::log2(minFrequency))) {
+            jassert(minFrequency > 0.f && maxFrequency > minFrequency);
+        }
+
+        float operator()(float frequency) const {
+            return (log2(frequency) - offset) * scale;
+        }
+
+        void map(const float* frequencies, float* positions, int numValues) const {
+            for (int i = 0; i < numValues; ++i) {
+                positions[i] = (log2(frequencies[i]) - offset) * scale;
+            }
+        }
+    private:
+        float offset;
+        float scale;
+    };
+}
@@ -0,0 +1,363 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.h
+    Created: 19 Oct 2026 1:11:29am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "ConfigExchange.h"
+#include "CrossoverFilter.h"
+#include "../Constants.h"
+
+//==============================================================================
+// Splits a signal into NumBands linear phase bands with FIR filters, for when phase shifts around the crossovers
+// matter more than latency.
+// Each crossover is a zero phase low pass with the magnitude of the Linkwitz-Riley filter of the chosen slope,
+// 1 / (1 + (f / fc)^order), windowed down to KernelLength taps. The bands are differences of neighbouring low passes
+// (the highest is a delayed impulse minus the top low pass), so they sum back to the input delayed by
+// getLatencySamples() exactly.
+// The kernels are applied by uniformly partitioned overlap-save convolution: the input is transformed once per
+// partition and per channel, every band reuses that spectrum from a frequency domain delay line, and only the
+// multiply-accumulate and one inverse transform are paid per band.
+// Designing the kernels takes far longer than a block, so it is done on the BackgroundBuilder thread: changing a
+// cutoff or slope only records the request, buildPendingKernels() designs a new set and publishes it through a
+// ConfigExchange, and the audio thread crossfades from the old kernels' output to the new ones' over one partition.
+// The convolution runs in single precision (juce::dsp::FFT is float only), double precision bands are converted on
+// the way in and out.
+// Same interface as CrossoverTree.
+template<int NumBands>
+struct LinearPhaseCrossover {
+    static_assert(NumBands >= 2, "a crossover needs at least two bands");
+    static constexpr int NumCrossovers = NumBands - 1;
+
+    static constexpr int PartitionSize = 1 << FIR_CROSSOVER_PARTITION_ORDER;
+    static constexpr int NumPartitions = 1 << FIR_CROSSOVER_PARTITIONS_ORDER;
+    static constexpr int KernelLength = PartitionSize * NumPartitions - 1; // odd, so the delay is a whole number of samples
+    static constexpr int NumBins = PartitionSize + 1;
+
+    // a partition is buffered before it is convolved, on top of the kernels' own delay
+    static constexpr int getLatencySamples() { return PartitionSize + (KernelLength - 1) / 2; }
+
+    // every crossover is LR4 until set, like CrossoverFilter's
+    LinearPhaseCrossover() {
+        slopes.fill(CrossoverSlope::LR4);
+        for (auto& slope : requestedSlopes) {
+            slope.store(CrossoverSlope::LR4, std::memory_order_relaxed);
+        }
+    }
+
+    // Message thread, while the builder is stopped. The first kernels are designed here for whatever cutoffs and
+    // slopes have been set so far, so processing starts with the right ones
+    void prepare(const juce::dsp::ProcessSpec& spec) {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<int>(spec.numChannels);
+
+        designer.prepare();
+        builtVersion = requestedVersion.load();
+        kernels.reset(designer.design(cutoffs, slopes, sampleRate));
+
+        inputHistory.setSize(numChannels, 2 * PartitionSize);
+        inputSpectra.resize(static_cast<size_t>(numChannels));
+        for (auto& spectra : inputSpectra) {
+            spectra.setSize(NumPartitions, 2 * NumBins);
+        }
+        for (auto& output : bandOutputs) {
+            output.setSize(numChannels, PartitionSize);
+        }
+        fadeBuffer.setSize(1, PartitionSize);
+        fftBuffer.assign(static_cast<size_t>(2 * fft.getSize()), 0.f);
+        accumulator.setSize(2, NumBins);
+
+        reset();
+    }
+
+    void reset() {
+        inputHistory.clear();
+        for (auto& spectra : inputSpectra) {
+            spectra.clear();
+        }
+        for (auto& output : bandOutputs) {
+            output.clear();
+        }
+        fillPosition = 0;
+        newestPartition = 0;
+    }
+
+    // index 0 is the lowest crossover. Only records the request, see buildPendingKernels()
+    void setCutoffFrequency(int index, float frequency) {
+        jassert(juce::isPositiveAndBelow(index, NumCrossovers));
+        auto& cutoff = cutoffs[static_cast<size_t>(index)];
+        if (cutoff != frequency) {
+            cutoff = frequency;
+            requestedCutoffs[static_cast<size_t>(index)].store(frequency, std::memory_order_relaxed);
+            requestedVersion.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void setSlope(int index, CrossoverSlope slope) {
+        jassert(juce::isPositiveAndBelow(index, NumCrossovers));
+        auto& current = slopes[static_cast<size_t>(index)];
+        if (current != slope) {
+            current = slope;
+            requestedSlopes[static_cast<size_t>(index)].store(slope, std::memory_order_relaxed);
+            requestedVersion.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    // Builder thread. Designs and publishes a new set of kernels if anything changed since the last one, and frees
+    // the sets the audio thread is done with. Requests made while it runs are picked up next time
+    void buildPendingKernels() {
+        kernels.collectGarbage();
+
+        auto version = requestedVersion.load(std::memory_order_acquire);
+        if (version == builtVersion) {
+            return;
+        }
+        builtVersion = version;
+
+        std::array<float, NumCrossovers> requested{};
+        std::array<CrossoverSlope, NumCrossovers> requestedSlope{};
+        for (size_t i = 0; i < requested.size(); ++i) {
+            requested[i] = requestedCutoffs[i].load(std::memory_order_relaxed);
+            requestedSlope[i] = requestedSlopes[i].load(std::memory_order_relaxed);
+        }
+        kernels.publish(designer.design(requested, requestedSlope, sampleRate));
+    }
+
+    // bands[0] holds the input on entry, every band buffer must already be the same size as it.
+    // Bands that aren't needed are neither convolved nor written
+    template<typename SampleType>
+    void process(std::array<juce::AudioBuffer<SampleType>, NumBands>& bands, const std::array<bool, NumBands>& bandNeeded) {
+        auto& input = bands[0];
+        auto numSamples = input.getNumSamples();
+
+        for (int start = 0; start < numSamples;) {
+            auto chunk = juce::jmin(numSamples - start, PartitionSize - fillPosition);
+
+            for (int chan = 0; chan < numChannels; ++chan) {
+                copySamples(input.getReadPointer(chan, start), inputHistory.getWritePointer(chan, PartitionSize + fillPosition), chunk);
+            }
+            for (size_t band = 0; band < bands.size(); ++band) {
+                if (!bandNeeded[band]) {
+                    continue;
+                }
+                for (int chan = 0; chan < numChannels; ++chan) {
+                    copySamples(bandOutputs[band].getReadPointer(chan, fillPosition), bands[band].getWritePointer(chan, start), chunk);
+                }
+            }
+
+            fillPosition += chunk;
+            start += chunk;
+            if (fillPosition == PartitionSize) {
+                convolvePartition(bandNeeded);
+                fillPosition = 0;
+            }
+        }
+    }
+private:
+    // one immutable set of kernels, [partition][re0, re1, ... reN, im0, im1, ... imN] per band. The real and
+    // imaginary halves are kept apart so the multiply-accumulate runs on plain float arrays
+    struct Kernels {
+        std::array<juce::AudioBuffer<float>, NumBands> spectra;
+    };
+
+    // everything the design needs, only ever used by one thread at a time
+    struct KernelDesigner {
+        void prepare() {
+            designBuffer.assign(static_cast<size_t>(2 * designFft.getSize()), 0.f);
+            fftBuffer.assign(static_cast<size_t>(2 * fft.getSize()), 0.f);
+            lowpassKernels.setSize(NumCrossovers, KernelLength);
+            window.resize(static_cast<size_t>(KernelLength));
+            juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), window.size(), juce::dsp::WindowingFunction<float>::blackmanHarris, false);
+        }
+
+        std::unique_ptr<Kernels> design(const std::array<float, NumCrossovers>& cutoffs, const std::array<CrossoverSlope, NumCrossovers>& slopes, double sampleRate) {
+            auto designSize = designFft.getSize();
+            auto centre = (KernelLength - 1) / 2;
+
+            for (int crossover = 0; crossover < NumCrossovers; ++crossover) {
+                auto cutoff = static_cast<double>(cutoffs[static_cast<size_t>(crossover)]);
+                auto order = getFilterOrder(slopes[static_cast<size_t>(crossover)]);
+
+                // the Linkwitz-Riley magnitude with no phase at all, the inverse transform leaves it centred on sample 0
+                for (int bin = 0; bin <= designSize / 2; ++bin) {
+                    auto frequency = static_cast<double>(bin) * sampleRate / static_cast<double>(designSize);
+                    designBuffer[static_cast<size_t>(2 * bin)] = static_cast<float>(1.0 / (1.0 + std::pow(frequency / juce::jmax(cutoff, 1.0), order)));
+                    designBuffer[static_cast<size_t>(2 * bin + 1)] = 0.f;
+                }
+                designFft.performRealOnlyInverseTransform(designBuffer.data());
+
+                auto* kernel = lowpassKernels.getWritePointer(crossover);
+                for (int tap = 0; tap < KernelLength; ++tap) {
+                    auto source = (tap - centre + designSize) % designSize;
+                    kernel[tap] = designBuffer[static_cast<size_t>(source)] * window[static_cast<size_t>(tap)];
+                }
+            }
+
+            auto kernels = std::make_unique<Kernels>();
+
+            // band k is the low pass above it minus the one below it, which makes the bands telescope back to an impulse
+            std::vector<float>& bandKernel = designBuffer;
+            for (int band = 0; band < NumBands; ++band) {
+                for (int tap = 0; tap < KernelLength; ++tap) {
+                    auto upper = band < NumCrossovers ? lowpassKernels.getSample(band, tap) : (tap == centre ? 1.f : 0.f);
+                    auto lower = band > 0 ? lowpassKernels.getSample(band - 1, tap) : 0.f;
+                    bandKernel[static_cast<size_t>(tap)] = upper - lower;
+                }
+
+                auto& spectra = kernels->spectra[static_cast<size_t>(band)];
+                spectra.setSize(NumPartitions, 2 * NumBins);
+                for (int partition = 0; partition < NumPartitions; ++partition) {
+                    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.f);
+                    auto first = partition * PartitionSize;
+                    auto length = juce::jmin(PartitionSize, KernelLength - first);
+                    std::copy(bandKernel.begin() + first, bandKernel.begin() + first + length, fftBuffer.begin());
+                    fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+                    deinterleave(fftBuffer, spectra.getWritePointer(partition));
+                }
+            }
+            return kernels;
+        }
+    private:
+        juce::dsp::FFT fft{ FIR_CROSSOVER_PARTITION_ORDER + 1 };
+        std::vector<float> fftBuffer;
+
+        // the kernels are designed on a grid twice as long as they are, so the truncated response doesn't alias
+        juce::dsp::FFT designFft{ FIR_CROSSOVER_PARTITION_ORDER + FIR_CROSSOVER_PARTITIONS_ORDER + 1 };
+        std::vector<float> designBuffer;
+        juce::AudioBuffer<float> lowpassKernels; // [crossover][tap]
+        std::vector<float> window;
+    };
+
+    double sampleRate{ 44100.0 };
+    int numChannels{ 0 };
+
+    // audio thread's view of the settings, and the requests it hands the builder
+    std::array<float, NumCrossovers> cutoffs{};
+    std::array<CrossoverSlope, NumCrossovers> slopes{};
+    std::array<std::atomic<float>, NumCrossovers> requestedCutoffs{};
+    std::array<std::atomic<CrossoverSlope>, NumCrossovers> requestedSlopes{};
+    std::atomic<juce::uint32> requestedVersion{ 0 };
+
+    // builder thread
+    KernelDesigner designer;
+    juce::uint32 builtVersion{ 0 };
+
+    ConfigExchange<Kernels> kernels;
+
+    juce::dsp::FFT fft{ FIR_CROSSOVER_PARTITION_ORDER + 1 };
+    std::vector<float> fftBuffer;
+    juce::AudioBuffer<float> accumulator; // [re|im][bin]
+
+    // overlap-save state, per channel
+    juce::AudioBuffer<float> inputHistory; // the previous partition, then the one being filled
+    std::vector<juce::AudioBuffer<float>> inputSpectra; // frequency domain delay line, laid out like the kernel spectra
+    std::array<juce::AudioBuffer<float>, NumBands> bandOutputs; // the last convolved partition
+    juce::AudioBuffer<float> fadeBuffer; // the outgoing kernels' output while crossfading
+    int fillPosition{ 0 };
+    int newestPartition{ 0 };
+
+    static double getFilterOrder(CrossoverSlope slope) {
+        switch (slope) {
+        case CrossoverSlope::LR2:
+            return 2.0;
+        case CrossoverSlope::LR8:
+            return 8.0;
+        default:
+            return 4.0;
+        }
+    }
+
+    template<typename Source, typename Dest>
+    static void copySamples(const Source* source, Dest* dest, int numSamples) {
+        std::transform(source, source + numSamples, dest, [](Source sample) { return static_cast<Dest>(sample); });
+    }
+
+    static void deinterleave(const std::vector<float>& interleaved, float* spectrum) {
+        for (int bin = 0; bin < NumBins; ++bin) {
+            spectrum[bin] = interleaved[static_cast<size_t>(2 * bin)];
+            spectrum[NumBins + bin] = interleaved[static_cast<size_t>(2 * bin + 1)];
+        }
+    }
+
+    void convolvePartition(const std::array<bool, NumBands>& bandNeeded) {
+        // new kernels are picked up between partitions, and faded in over the first one they convolve
+        kernels.swapIfPublished();
+        const auto& incoming = *kernels.getCurrent();
+        const auto* outgoing = kernels.getOutgoing();
+
+        newestPartition = (newestPartition + 1) % NumPartitions;
+
+        for (int chan = 0; chan < numChannels; ++chan) {
+            // one forward transform of the last two partitions of input, shared by every band
+            auto* history = inputHistory.getWritePointer(chan);
+            std::fill(fftBuffer.begin(), fftBuffer.end(), 0.f);
+            std::copy(history, history + 2 * PartitionSize, fftBuffer.begin());
+            fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+            deinterleave(fftBuffer, inputSpectra[static_cast<size_t>(chan)].getWritePointer(newestPartition));
+            std::copy(history + PartitionSize, history + 2 * PartitionSize, history);
+
+            for (size_t band = 0; band < bandNeeded.size(); ++band) {
+                auto& output = bandOutputs[band];
+                if (!bandNeeded[band]) {
+                    // nothing stale is left behind for when it is needed again
+                    output.clear(chan, 0, PartitionSize);
+                    continue;
+                }
+                convolveBand(chan, incoming.spectra[band], output.getWritePointer(chan));
+
+                // Both sets of kernels run on the same input history, so each side of the fade is continuous with
+                // the partitions around it and the bands still sum to the delayed input throughout
+                if (outgoing != nullptr) {
+                    convolveBand(chan, outgoing->spectra[band], fadeBuffer.getWritePointer(0));
+                    output.applyGainRamp(chan, 0, PartitionSize, 0.f, 1.f);
+                    output.addFromWithRamp(chan, 0, fadeBuffer.getReadPointer(0), PartitionSize, 1.f, 0.f);
+                }
+            }
+        }
+
+        if (outgoing != nullptr) {
+            kernels.retireOutgoing();
+        }
+    }
+
+    void convolveBand(int chan, const juce::AudioBuffer<float>& kernelSpectra, float* output) {
+        accumulator.clear();
+        auto* accRe = accumulator.getWritePointer(0);
+        auto* accIm = accumulator.getWritePointer(1);
+
+        const auto& spectra = inputSpectra[static_cast<size_t>(chan)];
+        for (int partition = 0; partition < NumPartitions; ++partition) {
+            // kernel partition p meets the input from p partitions ago
+            auto age = (newestPartition - partition + NumPartitions) % NumPartitions;
+            const auto* x = spectra.getReadPointer(age);
+            const auto* h = kernelSpectra.getReadPointer(partition);
+            const auto* xRe = x;
+            const auto* xIm = x + NumBins;
+            const auto* hRe = h;
+            const auto* hIm = h + NumBins;
+            for (int bin = 0; bin < NumBins; ++bin) {
+                accRe[bin] += xRe[bin] * hRe[bin] - xIm[bin] * hIm[bin];
+                accIm[bin] += xRe[bin] * hIm[bin] + xIm[bin] * hRe[bin];
+            }
+        }
+
+        for (int bin = 0; bin < NumBins; ++bin) {
+            fftBuffer[static_cast<size_t>(2 * bin)] = accRe[bin];
+            fftBuffer[static_cast<size_t>(2 * bin + 1)] = accIm[bin];
+        }
+        fft.performRealOnlyInverseTransform(fftBuffer.data());
+
+        // overlap-save: only the second half is free of circular wrap around
+        std::copy(fftBuffer.begin() + PartitionSize, fftBuffer.begin() + 2 * PartitionSize, output);
+    }
+};
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    MultirateResampler.cpp
+    Created: 19 Oct 2026 12:46:47am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "MultirateResampler.h"
+#include "../Constants.h"
+
+void MultirateResampler::prepare(double sampleRate, int maximumBlockSize, int numChannels) {
+    factor = 1;
+    while (sampleRate / static_cast<double>(factor * 2) >= MULTIRATE_MIN_SAMPLE_RATE) {
+        factor *= 2;
+    }
+    reducedSampleRate = sampleRate / static_cast<double>(factor);
+
+    tapsPerPhase = MULTIRATE_TAPS_PER_PHASE;
+    numTaps = factor * tapsPerPhase;
+    designTaps();
+
+    inputHistory.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(2 * numTaps), 0.f));
+    reducedHistory.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(2 * tapsPerPhase), 0.f));
+    maxReducedSamples = maximumBlockSize / factor + 1;
+    reducedBuffer.setSize(numChannels, maxReducedSamples);
+    reset();
+}
+
+void MultirateResampler::reset() {
+    for (auto& history : inputHistory) {
+        std::fill(history.begin(), history.end(), 0.f);
+    }
+    for (auto& history : reducedHistory) {
+        std::fill(history.begin(), history.end(), 0.f);
+    }
+    inputWritePos = 0;
+    reducedWritePos = 0;
+    phase = 0;
+    blockStartPhase = 0;
+}
+
+void MultirateResampler::designTaps() {
+    // Windowed sinc. The band feeding this is already low passed at <= 1 kHz by the crossover, so the cutoff only has
+    // to stop anything that would fold back around the reduced Nyquist; a quarter of the reduced rate leaves room for
+    // the transition band.
+    const double cutoff = 0.25 / static_cast<double>(factor);
+    const double centre = 0.5 * static_cast<double>(numTaps - 1);
+
+    decimationTaps.assign(static_cast<size_t>(numTaps), 0.f);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(decimationTaps.data(), static_cast<size_t>(numTaps),
+        juce::dsp::WindowingFunction<float>::kaiser, false, MULTIRATE_KAISER_BETA);
+
+    double sum = 0.0;
+    for (int i = 0; i < numTaps; ++i) {
+        const double x = 2.0 * cutoff * (static_cast<double>(i) - centre);
+        const double sinc = (x == 0.0) ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+        const double tap = 2.0 * cutoff * sinc * decimationTaps[static_cast<size_t>(i)];
+        decimationTaps[static_cast<size_t>(i)] = static_cast<float>(tap);
+        sum += tap;
+    }
+
+    // unity gain at DC
+    for (auto& tap : decimationTaps) {
+        tap = static_cast<float>(tap / sum);
+    }
+
+    // Branch p of the interpolator only ever sees taps p, p + factor, p + 2 * factor ... since the rest land on the zeros
+    // a zero-stuffing upsampler would insert. The factor makes up for the energy those zeros took away.
+    interpolationTaps.assign(static_cast<size_t>(factor), std::vector<float>(static_cast<size_t>(tapsPerPhase), 0.f));
+    for (int p = 0; p < factor; ++p) {
+        for (int i = 0; i < tapsPerPhase; ++i) {
+            auto tapIndex = static_cast<size_t>((tapsPerPhase - 1 - i) * factor + p);
+            interpolationTaps[static_cast<size_t>(p)][static_cast<size_t>(i)] = static_cast<float>(factor) * decimationTaps[tapIndex];
+        }
+    }
+}
+
+template<typename SampleType>
+juce::AudioBuffer<float>& MultirateResampler::decimate(const juce::AudioBuffer<SampleType>& buffer) {
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(inputHistory.size()));
+
+    // an output is produced every time the phase wraps to zero
+    const int firstOutput = (factor - phase) % factor;
+    const int numReduced = firstOutput < numSamples ? (numSamples - firstOutput + factor - 1) / factor : 0;
+    jassert(numReduced <= maxReducedSamples);
+    reducedBuffer.setSize(numChannels, numReduced, false, false, true);
+
+    blockStartPhase = phase;
+    int writePos = inputWritePos;
+    int p = phase;
+
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto& history = inputHistory[static_cast<size_t>(chan)];
+        const SampleType* input = buffer.getReadPointer(chan);
+        float* output = reducedBuffer.getWritePointer(chan);
+        writePos = inputWritePos;
+        p = phase;
+        int outputIndex = 0;
+
+        for (int i = 0; i < numSamples; ++i) {
+            writePos = (writePos + 1 == numTaps) ? 0 : writePos + 1;
+            const auto sample = static_cast<float>(input[i]);
+            history[static_cast<size_t>(writePos)] = sample;
+            history[static_cast<size_t>(writePos + numTaps)] = sample;
+
+            if (p == 0) {
+                // history[writePos + 1 ... writePos + numTaps] is the last numTaps samples, oldest first
+                const float* window = history.data() + writePos + 1;
+                float sum = 0.f;
+                for (int tap = 0; tap < numTaps; ++tap) {
+                    sum += window[tap] * decimationTaps[static_cast<size_t>(tap)];
+                }
+                output[outputIndex++] = sum;
+            }
+            p = (p + 1 == factor) ? 0 : p + 1;
+        }
+        jassert(outputIndex == numReduced);
+    }
+
+    inputWritePos = writePos;
+    phase = p;
+    return reducedBuffer;
+}
+
+template<typename SampleType>
+void MultirateResampler::interpolate(juce::AudioBuffer<SampleType>& buffer) {
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), reducedBuffer.getNumChannels());
+    int writePos = reducedWritePos;
+
+    for (int chan = 0; chan < numChannels; ++chan) {
+        auto& history = reducedHistory[static_cast<size_t>(chan)];
+        const float* input = reducedBuffer.getReadPointer(chan);
+        SampleType* output = buffer.getWritePointer(chan);
+        writePos = reducedWritePos;
+        int p = blockStartPhase;
+        int inputIndex = 0;
+
+        for (int i = 0; i < numSamples; ++i) {
+            if (p == 0) {
+                writePos = (writePos + 1 == tapsPerPhase) ? 0 : writePos + 1;
+                history[static_cast<size_t>(writePos)] = input[inputIndex];
+                history[static_cast<size_t>(writePos + tapsPerPhase)] = input[inputIndex];
+                ++inputIndex;
+            }
+
+            const float* window = history.data() + writePos + 1;
+            const auto& taps = interpolationTaps[static_cast<size_t>(p)];
+            float sum = 0.f;
+            for (int tap = 0; tap < tapsPerPhase; ++tap) {
+                sum += window[tap] * taps[static_cast<size_t>(tap)];
+            }
+            output[i] = static_cast<SampleType>(sum);
+            p = (p + 1 == factor) ? 0 : p + 1;
+        }
+    }
+
+    reducedWritePos = writePos;
+}
+
+template juce::AudioBuffer<float>& MultirateResampler::decimate(const juce::AudioBuffer<float>&);
+template juce::AudioBuffer<float>& MultirateResampler::decimate(const juce::AudioBuffer<double>&);
+template void MultirateResampler::interpolate(juce::AudioBuffer<float>&);
+template void MultirateResampler::interpolate(juce::AudioBuffer<double>&);
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    MultirateResampler.h
+    Created: 19 Oct 2026 12:46:47am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+// Runs a band-limited band at a fraction of the host rate.
+// decimate() filters and downsamples a block into the reduced rate buffer, whatever processing is needed runs on that
+// buffer, then interpolate() brings it back up to the host rate. Both directions share one linear phase lowpass
+// split into polyphase branches, so only the samples that survive (or that are non-zero) are ever multiplied.
+// The round trip delays the band by getLatencySamples(), every other path must be delayed by the same amount.
+struct MultirateResampler {
+    // picks the largest power of two factor that keeps the reduced rate at or above MULTIRATE_MIN_SAMPLE_RATE,
+    // a factor of 1 means the band is left at the host rate
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels);
+    void reset();
+
+    bool isActive() const { return factor > 1; }
+    int getFactor() const { return factor; }
+    double getReducedSampleRate() const { return reducedSampleRate; }
+    // in host rate samples
+    int getLatencySamples() const { return isActive() ? numTaps - 1 : 0; }
+
+    // The returned buffer holds the decimated block, process it in place before calling interpolate().
+    // The filters and the reduced rate band are single precision whatever the host buffer is, the low band only holds
+    // a low passed signal and the histories are FIR, nothing here accumulates error
+    template<typename SampleType>
+    juce::AudioBuffer<float>& decimate(const juce::AudioBuffer<SampleType>& buffer);
+    // overwrites buffer (same size as the one given to decimate()) with the upsampled contents of the reduced buffer
+    template<typename SampleType>
+    void interpolate(juce::AudioBuffer<SampleType>& buffer);
+private:
+    int factor{ 1 };
+    int tapsPerPhase{ 0 };
+    int numTaps{ 0 };
+    double reducedSampleRate{ 44100.0 };
+
+    std::vector<float> decimationTaps;                // numTaps, symmetric so no need to reverse them
+    std::vector<std::vector<float>> interpolationTaps; // [phase][tap], reversed and scaled by the factor
+
+    // histories are stored twice over so a whole window can always be read contiguously
+    std::vector<std::vector<float>> inputHistory;  // [channel][2 * numTaps]
+    std::vector<std::vector<float>> reducedHistory; // [channel][2 * tapsPerPhase]
+    int inputWritePos{ 0 };
+    int reducedWritePos{ 0 };
+
+    // host rate position within the current decimation period, shared by both directions so they stay in step
+    int phase{ 0 };
+    int blockStartPhase{ 0 };
+
+    juce::AudioBuffer<float> reducedBuffer;
+    int maxReducedSamples{ 0 };
+
+    void designTaps();
+};
@@ -9,3 +9,50 @@
 */
 
 #include "Params.h"
+
+namespace Params {
+    juce::String getBandName(int band) {
+        jassert(juce::isPositiveAndBelow(band, NUM_BANDS));
+        switch (NUM_BANDS) {
+        case 2:
+            return juce::StringArray{ "Low", "High" }[band];
+        case 3:
+            return juce::StringArray{ "Low", "Mid", "High" }[band];
+        case 4:
+            return juce::StringArray{ "Low", "Low Mid", "High Mid", "High" }[band];
+        default:
+            return juce::StringArray{ "Low", "Low Mid", "Mid", "High Mid", "High" }[band];
+        }
+    }
+
+    juce::String getBandParamName(BandParam param, int band) {
+        static const juce::StringArray prefixes{ "Threshold", "Attack", "Release", "Ratio", "Bypassed", "Mute", "Solo", "Lookahead", "Oversampling", "Control Rate" };
+        return prefixes[static_cast<int>(param)] + " " + getBandName(band) + " Band";
+    }
+
+    juce::String getCrossoverParamName(int index) {
+        jassert(juce::isPositiveAndBelow(index, NUM_BANDS - 1));
+        return getBandName(index) + "-" + getBandName(index + 1) + " Crossover Freq";
+    }
+
+    juce::String getCrossoverSlopeParamName(int index) {
+        jassert(juce::isPositiveAndBelow(index, NUM_BANDS - 1));
+        return getBandName(index) + "-" + getBandName(index + 1) + " Crossover Slope";
+    }
+
+    CrossoverRange getCrossoverRange(int index) {
+        jassert(juce::isPositiveAndBelow(index, NUM_BANDS - 1));
+        if (NUM_BANDS == 3) {
+            return index == 0 ? CrossoverRange{ LOW_MID_MIN_FREQ, LOW_MID_MAX_FREQ, LOW_MID_CROSSOVER_DEFAULT_FREQUENCY }
+                              : CrossoverRange{ MID_HIGH_MIN_FREQ, MID_HIGH_MAX_FREQ, MID_HIGH_CROSSOVER_DEFAULT_FREQUENCY };
+        }
+
+        // otherwise the audible range is cut into equal windows on a log scale, defaulting to the middle of each
+        auto windowOctaves = std::log2(MAX_FREQ / MIN_FREQ) / static_cast<float>(NUM_BANDS - 1);
+        auto min = MIN_FREQ * std::exp2(windowOctaves * static_cast<float>(index));
+        auto max = MIN_FREQ * std::exp2(windowOctaves * static_cast<float>(index + 1));
+        // neighbouring windows stay one step apart, like the three band ranges
+        auto isHighest = index == NUM_BANDS - 2;
+        return { std::round(min), isHighest ? MAX_FREQ : std::round(max) - DEFAULT_INTERVAL, std::round(std::sqrt(min * max)) };
+    }
+}
@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../Constants.h"
 
 namespace Params {
     enum Names {
@@ -45,7 +46,13 @@ namespace Params {
         SoloHighBand,
 
         GainIn,
-        GainOut
+        GainOut,
+
+        GlobalBypass,
+        CrossoverMode,
+        OversamplingFilter,
+        ChannelLink,
+        SpectralBands
     };
 
     inline const std::map<Names, juce::String>& GetParams() {
@@ -75,7 +82,43 @@ namespace Params {
             { SoloHighBand, "Solo High Band"},
             { GainIn, "Gain In"},
             { GainOut, "Gain Out"},
+            { GlobalBypass, "Global Bypass"},
+            { CrossoverMode, "Crossover Mode"},
+            { OversamplingFilter, "Oversampling Filter"},
+            { ChannelLink, "Channel Link"},
+            { SpectralBands, "Spectral Bands"},
         };
         return params;
     }
+
+    // Per band parameters for any band count. With three bands these give the same IDs as GetParams(), so
+    // sessions saved by the three band build still load
+    enum class BandParam {
+        Threshold,
+        Attack,
+        Release,
+        Ratio,
+        Bypassed,
+        Mute,
+        Solo,
+        Lookahead,
+        Oversampling,
+        ControlRate
+    };
+
+    // "Low", "Mid", "High", with "Low Mid"/"High Mid" filling in between for four and five bands
+    juce::String getBandName(int band);
+    juce::String getBandParamName(BandParam param, int band);
+    // index 0 is the lowest crossover, e.g. "Low-Mid Crossover Freq"
+    juce::String getCrossoverParamName(int index);
+    // e.g. "Low-Mid Crossover Slope"
+    juce::String getCrossoverSlopeParamName(int index);
+
+    struct CrossoverRange {
+        float min;
+        float max;
+        float defaultValue;
+    };
+    // Each crossover gets its own window of the spectrum, so they can never be dragged past one another
+    CrossoverRange getCrossoverRange(int index);
 }
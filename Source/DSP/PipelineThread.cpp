@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    PipelineThread.cpp
+    Created: 19 Oct 2026 1:42:17am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "PipelineThread.h"
+#include "../Constants.h"
+
+PipelineThread::Helper::Helper(PipelineThread& pipelineThread) :
+    juce::Thread("SimpleMBComp Pipeline"),
+    owner(pipelineThread) {}
+
+PipelineThread::Helper::~Helper() {
+    stopThread(-1);
+}
+
+void PipelineThread::Helper::run() {
+    juce::ScopedNoDenormals noDenormals;
+
+    while (!threadShouldExit()) {
+        auto done = owner.finished.load(std::memory_order_relaxed);
+        auto spins = 0;
+        auto next = owner.launched.load(std::memory_order_acquire);
+        while (next == done && spins < WORKER_POOL_SPIN_ITERATIONS && !threadShouldExit()) {
+            ++spins;
+            next = owner.launched.load(std::memory_order_acquire);
+        }
+
+        if (next == done) {
+            // the same announce-then-check as the WorkerPool's workers, so a launch can't slip past the sleep
+            isSleeping.store(true, std::memory_order_seq_cst);
+            if (owner.launched.load(std::memory_order_seq_cst) == done && !threadShouldExit()) {
+                wakeUp.wait(WORKER_POOL_SLEEP_TIMEOUT_MS);
+            }
+            isSleeping.store(false, std::memory_order_seq_cst);
+            continue;
+        }
+
+        owner.jobInvoke(owner.jobContext);
+        owner.finished.store(next, std::memory_order_release);
+    }
+}
+
+PipelineThread::~PipelineThread() {
+    stop();
+}
+
+void PipelineThread::start() {
+    stop();
+    launched.store(0);
+    finished.store(0);
+    thread = std::make_unique<Helper>(*this);
+    // the audio thread waits on it, so it runs with its priority
+    thread->startRealtimeThread(juce::Thread::RealtimeOptions{});
+}
+
+void PipelineThread::stop() {
+    if (thread != nullptr) {
+        thread->signalThreadShouldExit();
+        thread->wakeUp.signal();
+        thread.reset();
+    }
+}
+
+void PipelineThread::launchJob(void* context, Invoke invoke) {
+    jassert(finished.load(std::memory_order_relaxed) == launched.load(std::memory_order_relaxed));
+    // the job goes out before the count that announces it
+    jobContext = context;
+    jobInvoke = invoke;
+    launched.store(launched.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    if (thread->isSleeping.load(std::memory_order_seq_cst)) {
+        thread->wakeUp.signal();
+    }
+}
+
+void PipelineThread::wait() {
+    auto target = launched.load(std::memory_order_relaxed);
+    auto spins = 0;
+    while (finished.load(std::memory_order_acquire) != target) {
+        if (++spins > WORKER_POOL_SPIN_ITERATIONS) {
+            juce::Thread::yield();
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    PipelineThread.h
+    Created: 19 Oct 2026 1:42:17am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+// One real time thread that runs a job alongside the audio thread, for the pipelined mode.
+// launch() hands the job over and returns straight away, wait() returns once it has finished. Like the WorkerPool's
+// workers the thread spins for a while after each job and then sleeps, and the audio thread only ever spins and yields.
+// Without a thread, launch() simply runs the job itself
+struct PipelineThread {
+    ~PipelineThread();
+
+    // message thread, while the audio thread isn't using it
+    void start();
+    void stop();
+    bool isRunning() const { return thread != nullptr; }
+
+    // Audio thread. The job has to stay alive until wait(), and every launch() needs its wait() before the next one
+    template<typename Job>
+    void launch(Job& job) {
+        if (thread == nullptr) {
+            job();
+            return;
+        }
+        launchJob(&job, [](void* context) { (*static_cast<Job*>(context))(); });
+    }
+    void wait();
+private:
+    using Invoke = void (*)(void*);
+
+    struct Helper : juce::Thread {
+        explicit Helper(PipelineThread& owner);
+        ~Helper() override;
+        void run() override;
+
+        juce::WaitableEvent wakeUp;
+        std::atomic<bool> isSleeping{ false };
+    private:
+        PipelineThread& owner;
+    };
+
+    std::unique_ptr<Helper> thread;
+
+    void* jobContext{ nullptr };
+    Invoke jobInvoke{ nullptr };
+    // a job is running while finished lags behind launched
+    std::atomic<juce::uint32> launched{ 0 };
+    std::atomic<juce::uint32> finished{ 0 };
+
+    void launchJob(void* context, Invoke invoke);
+};
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    SimdDispatch.cpp
+    Created: 19 Oct 2026 1:53:56am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "SimdDispatch.h"
+
+bool SimdDispatch::isSupported(SimdPath path) {
+    switch (path) {
+    case SimdPath::Baseline:
+        return true;
+   #if MBCOMP_SIMD_DISPATCH
+    case SimdPath::Avx2:
+        return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+    case SimdPath::Avx512:
+        return isSupported(SimdPath::Avx2) && juce::SystemStats::hasAVX512F();
+   #endif
+    default:
+        return false;
+    }
+}
+
+SimdPath SimdDispatch::getFastestSupported() {
+    for (auto path : { SimdPath::Avx512, SimdPath::Avx2 }) {
+        if (isSupported(path)) {
+            return path;
+        }
+    }
+    return SimdPath::Baseline;
+}
+
+SimdPath SimdDispatch::resolve(SimdPath requested) {
+    if (requested == SimdPath::Automatic) {
+        return getFastestSupported();
+    }
+    // forcing a path the CPU can't run would crash on the first illegal instruction
+    jassert(isSupported(requested));
+    return isSupported(requested) ? requested : getFastestSupported();
+}
+
+juce::String SimdDispatch::getName(SimdPath path) {
+    switch (path) {
+    case SimdPath::Automatic:
+        return "Automatic";
+    case SimdPath::Avx2:
+        return "AVX2";
+    case SimdPath::Avx512:
+        return "AVX-512";
+    default:
+       #if JUCE_INTEL
+        return "SSE2";
+       #else
+        return "Baseline";
+       #endif
+    }
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    SimdDispatch.h
+    Created: 19 Oct 2026 1:53:56am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// The instruction sets the hot kernels are built for, on top of the baseline the plugin is compiled for.
+// Each path's kernels live in their own translation unit (CompressorKernelAvx2.cpp, SimdKernelsAvx512.cpp, ...) and the
+// processor picks one path in prepareToPlay(). GCC and Clang build those with the target attributes below, MSVC builds
+// the whole file with /arch:AVX2 or /arch:AVX512 through the AVX2 and AVX512 compiler flag schemes in the .jucer.
+// Anything else on Intel, and everything off it, only ever reports the baseline as supported
+enum class SimdPath {
+    Automatic = -1, // the fastest the CPU supports, only as a request
+    Baseline,       // SSE2 on Intel
+    Avx2,           // AVX2 and FMA
+    Avx512          // AVX-512F on top of those
+};
+
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define MBCOMP_SIMD_DISPATCH 1
+ #define MBCOMP_TARGET_AVX2 __attribute__((target("avx2,fma")))
+ #define MBCOMP_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+ // the shared body is inlined into every target's wrapper, so each one gets compiled for that target
+ #define MBCOMP_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif JUCE_INTEL && JUCE_MSVC
+ #define MBCOMP_SIMD_DISPATCH 1
+ #define MBCOMP_TARGET_AVX2
+ #define MBCOMP_TARGET_AVX512
+ // no target attributes, the files themselves are compiled for the path
+ #define MBCOMP_ALWAYS_INLINE __forceinline
+#else
+ #define MBCOMP_SIMD_DISPATCH 0
+ #define MBCOMP_TARGET_AVX2
+ #define MBCOMP_TARGET_AVX512
+ #define MBCOMP_ALWAYS_INLINE inline
+#endif
+
+namespace SimdDispatch {
+    bool isSupported(SimdPath path);
+    SimdPath getFastestSupported();
+    // requested if this CPU supports it, the fastest supported path otherwise
+    SimdPath resolve(SimdPath requested);
+    juce::String getName(SimdPath path);
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    SimdKernels.cpp
+    Created: 19 Oct 2026 1:53:56am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "SimdKernelsBody.h"
+
+template<typename SampleType>
+void SimdKernels::addWithRamp(SimdPath path, SampleType* dest, const SampleType* source, int numSamples, float startGain, float endGain) {
+    if (numSamples <= 0) {
+        return;
+    }
+    switch (path) {
+    case SimdPath::Avx512:
+        addWithRampAvx512(dest, source, numSamples, startGain, endGain);
+        break;
+    case SimdPath::Avx2:
+        addWithRampAvx2(dest, source, numSamples, startGain, endGain);
+        break;
+    default:
+        addWithRampBody(dest, source, numSamples, startGain, endGain);
+        break;
+    }
+}
+
+template void SimdKernels::addWithRamp(SimdPath, float*, const float*, int, float, float);
+template void SimdKernels::addWithRamp(SimdPath, double*, const double*, int, float, float);
+
+void SimdKernels::magnitudesToDecibels(SimdPath path, float* bins, int numBins, float scale, float minusInfinityDb) {
+    switch (path) {
+    case SimdPath::Avx512:
+        magnitudesToDecibelsAvx512(bins, numBins, scale, minusInfinityDb);
+        break;
+    case SimdPath::Avx2:
+        magnitudesToDecibelsAvx2(bins, numBins, scale, minusInfinityDb);
+        break;
+    default:
+        magnitudesToDecibelsBody(bins, numBins, scale, minusInfinityDb);
+        break;
+    }
+}
@@ -0,0 +1,27 @@
+/*
+  ==============================================================================
+
+    SimdKernels.h
+    Created: 19 Oct 2026 1:53:56am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "SimdDispatch.h"
+
+//==============================================================================
+// The small array kernels outside the compressor, each built for every SimdPath
+namespace SimdKernels {
+    // dest += source * gain, with the gain ramping linearly from startGain towards endGain like
+    // juce::AudioBuffer::addFromWithRamp(). Each sample's gain is computed from its index rather than accumulated,
+    // so the loop vectorises
+    template<typename SampleType>
+    void addWithRamp(SimdPath path, SampleType* dest, const SampleType* source, int numSamples, float startGain, float endGain);
+
+    // FFT magnitudes to decibels in place: bins that aren't finite become silence, the rest are scaled and converted
+    // with FastMath::gainToDecibels(), floored at minusInfinityDb
+    void magnitudesToDecibels(SimdPath path, float* bins, int numBins, float scale, float minusInfinityDb);
+}
@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    SimdKernelsAvx512.cpp
+    Created: 19 Oct 2026 2:41:50am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "SimdKernelsBody.h"
+
+template<typename SampleType>
+MBCOMP_TARGET_AVX512 void SimdKernels::addWithRampAvx512(SampleType* dest, const SampleType* source, int numSamples, float startGain, float endGain) {
+    addWithRampBody(dest, source, numSamples, startGain, endGain);
+}
+
+template void SimdKernels::addWithRampAvx512(float*, const float*, int, float, float);
+template void SimdKernels::addWithRampAvx512(double*, const double*, int, float, float);
+
+MBCOMP_TARGET_AVX512 void SimdKernels::magnitudesToDecibelsAvx512(float* bins, int numBins, float scale, float minusInfinityDb) {
+    magnitudesToDecibelsBody(bins, numBins, scale, minusInfinityDb);
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    SimdKernelsBody.h
+    Created: 19 Oct 2026 2:41:50am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "SimdKernels.h"
+#include "FastMath.h"
+
+//==============================================================================
+// The kernels' bodies, included by SimdKernels.cpp and by the file of every other SimdPath so each is compiled for
+// its own instruction set. Internal linkage, so the linker never swaps one file's copy for another's
+namespace {
+    template<typename SampleType>
+    MBCOMP_ALWAYS_INLINE void addWithRampBody(SampleType* dest, const SampleType* source, int numSamples, float startGain, float endGain) {
+        const auto start = static_cast<SampleType>(startGain);
+        const auto increment = static_cast<SampleType>(endGain - startGain) / static_cast<SampleType>(numSamples);
+        for (int i = 0; i < numSamples; ++i) {
+            dest[i] += source[i] * (start + increment * static_cast<SampleType>(i));
+        }
+    }
+
+    MBCOMP_ALWAYS_INLINE void magnitudesToDecibelsBody(float* bins, int numBins, float scale, float minusInfinityDb) {
+        for (int i = 0; i < numBins; ++i) {
+            // All exponent bits set is inf or NaN. Those are masked to zero on the bits after scaling every bin, as GCC
+            // won't vectorise a select around a float operation
+            const auto isFinite = (FastMath::toBits(bins[i]) & 0x7f800000) != 0x7f800000;
+            const auto finiteMask = -static_cast<std::int32_t>(isFinite);
+            const auto magnitude = FastMath::fromBits(FastMath::toBits(bins[i] * scale) & finiteMask);
+            bins[i] = FastMath::gainToDecibels(magnitude, minusInfinityDb);
+        }
+    }
+}
+
+// defined in SimdKernelsAvx2.cpp and SimdKernelsAvx512.cpp
+namespace SimdKernels {
+    template<typename SampleType>
+    MBCOMP_TARGET_AVX2 void addWithRampAvx2(SampleType* dest, const SampleType* source, int numSamples, float startGain, float endGain);
+    template<typename SampleType>
+    MBCOMP_TARGET_AVX512 void addWithRampAvx512(SampleType* dest, const SampleType* source, int numSamples, float startGain, float endGain);
+    MBCOMP_TARGET_AVX2 void magnitudesToDecibelsAvx2(float* bins, int numBins, float scale, float minusInfinityDb);
+    MBCOMP_TARGET_AVX512 void magnitudesToDecibelsAvx512(float* bins, int numBins, float scale, float minusInfinityDb);
+}
@@ -10,7 +10,9 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include "Fifo.h"
+#include "../Constants.h"
 
 //==============================================================================
 enum Channel {
@@ -28,16 +30,40 @@ template<typename BlockType>
 struct SingleChannelSampleFifo {
     SingleChannelSampleFifo(Channel ch) : channelToUse(ch) {
         prepared.set(false);
+        sourceChannels[0] = channelToUse;
     }
 
-    void update(const BlockType& buffer) {
+    // Message thread, while not processing. The samples pushed are the average of these channels, see ChannelLayout
+    void setSourceChannels(const juce::Array<int>& channels) {
+        jassert(!channels.isEmpty() && channels.size() <= MAX_CHANNELS);
+        numSourceChannels = juce::jlimit(1, MAX_CHANNELS, channels.size());
+        for (int i = 0; i < numSourceChannels; ++i) {
+            sourceChannels[static_cast<size_t>(i)] = channels[i];
+        }
+    }
+
+    // the host's buffer may be double precision, the analyzer always works on floats
+    template<typename SampleType>
+    void update(const juce::AudioBuffer<SampleType>& buffer) {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse);
-        // auto is ok here because we don't nessecarily know the type of buffer (BlockType is a template)
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        if (numSourceChannels == 1) {
+            jassert(buffer.getNumChannels() > sourceChannels[0]);
+            // auto is ok here because we don't nessecarily know the type of buffer (BlockType is a template)
+            auto* channelPtr = buffer.getReadPointer(sourceChannels[0]);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                pushNextSampleIntoFifo(static_cast<float>(channelPtr[i]));
+            }
+            return;
+        }
 
+        auto scale = 1.f / static_cast<float>(numSourceChannels);
         for (int i = 0; i < buffer.getNumSamples(); ++i) {
-            pushNextSampleIntoFifo(channelPtr[i]);
+            auto sum = 0.f;
+            for (int source = 0; source < numSourceChannels; ++source) {
+                sum += static_cast<float>(buffer.getSample(sourceChannels[static_cast<size_t>(source)], i));
+            }
+            pushNextSampleIntoFifo(sum * scale);
         }
     }
 
@@ -63,6 +89,8 @@ struct SingleChannelSampleFifo {
 
 private:
     Channel channelToUse;
+    std::array<int, MAX_CHANNELS> sourceChannels{};
+    int numSourceChannels = 1;
     int fifoIndex = 0;
     Fifo<BlockType> audioBufferFifo;
     BlockType bufferToFill;
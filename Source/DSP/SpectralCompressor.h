@@ -0,0 +1,466 @@
+/*
+  ==============================================================================
+
+    SpectralCompressor.h
+    Created: 19 Oct 2026 2:05:34am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "CompressorKernel.h"
+#include "FastMath.h"
+#include "../Constants.h"
+
+//==============================================================================
+// Compresses 16 to 64 bands in the frequency domain, for restoration and broadcast work where cascaded IIR splits
+// would be far too many filters. Splits the signal into NumBands plugin bands and compresses them in one go, so it
+// takes the place of both the crossover and the kernels.
+// Runs a short time Fourier transform: Hann windowed frames of FrameSize samples, one every HopSize samples, are
+// windowed again after the inverse transform and overlap-added, which sums back to the input exactly when no gain is
+// applied. The bins are grouped into spectral bands spaced evenly on the ERB scale, none narrower than the window's
+// main lobe, as a narrower band would only ever see part of a tone.
+// Each spectral band has an envelope per channel, fed once per hop with the band's level and run with the attack and
+// release of the plugin band its centre falls in, so the ballistics match the kernel's in time. The gain computer is
+// the kernel's too, and its gain applies to every bin of the band. The detector reads one bin past each edge, so a
+// tone between two bands is compressed by both as if it sat in either (broadband noise reads up to 1.8 dB hot in the
+// narrowest bands for it). Steady sines come out within 0.1 dB of the kernel's gain wherever they fall.
+// Each plugin band is resynthesised from its own range of bins, cut at the crossover frequencies. Apart from the
+// envelopes, everything per hop is paid per bin: one forward transform per channel, one inverse transform per
+// channel and plugin band, and a few passes over the bins. The band count only adds its envelopes and gain computers.
+// Runs in single precision like LinearPhaseCrossover, double precision bands are converted on the way in and out.
+// Lookahead, oversampling and control rate don't apply, the meters follow the kernel's model (see getBandLevels()).
+template<int NumBands>
+struct SpectralCompressor {
+    static constexpr int FrameSize = 1 << SPECTRAL_FFT_ORDER;
+    static constexpr int HopSize = FrameSize / SPECTRAL_OVERLAP;
+    static constexpr int NumBins = FrameSize / 2 + 1;
+    static constexpr int MaxSpectralBands = SPECTRAL_BANDS_MAX;
+    static constexpr int MinBinsPerBand = 4; // a periodic Hann window's main lobe
+
+    // a sample is heard once the last frame it falls in has been resynthesised
+    static constexpr int getLatencySamples() { return FrameSize; }
+
+    void prepare(const juce::dsp::ProcessSpec& spec) {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<int>(spec.numChannels);
+        jassert(numChannels <= MAX_CHANNELS);
+
+        // periodic Hann, so the squared windows of overlapping frames add up to a constant
+        window.resize(static_cast<size_t>(FrameSize));
+        auto sumOfSquares = 0.f;
+        for (size_t i = 0; i < window.size(); ++i) {
+            window[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / static_cast<float>(FrameSize));
+            sumOfSquares += window[i] * window[i];
+        }
+        overlapAddScale = static_cast<float>(HopSize) / sumOfSquares;
+        // Parseval over the positive bins, then divided by the window's power: the mean square of the band's signal
+        powerScale = 2.f / (static_cast<float>(FrameSize) * sumOfSquares);
+
+        inputFrames.setSize(numChannels, FrameSize);
+        spectra.setSize(numChannels, 2 * NumBins);
+        for (auto& output : bandOutputs) {
+            output.setSize(numChannels, FrameSize);
+        }
+        fftBuffer.assign(static_cast<size_t>(2 * FrameSize), 0.f);
+        for (int chan = 0; chan < MAX_CHANNELS; ++chan) {
+            linkGroups[static_cast<size_t>(chan)] = chan;
+            meterWeights[static_cast<size_t>(chan)] = 1.f;
+        }
+
+        // every layout the band count can switch to is worked out here, so switching never runs pow() and log10()
+        // on the audio thread
+        bandLayouts.resize(SPECTRAL_BAND_COUNTS.size());
+        for (size_t i = 0; i < bandLayouts.size(); ++i) {
+            calculateBandLayout(bandLayouts[i], SPECTRAL_BAND_COUNTS[i]);
+        }
+        bandLayout = &bandLayouts[getLayoutIndex(numSpectralBands)];
+        updateCrossoverBins();
+        reset();
+    }
+
+    void reset() {
+        inputFrames.clear();
+        for (auto& output : bandOutputs) {
+            output.clear();
+        }
+        for (auto& envelope : envelopes) {
+            envelope.fill(0.f);
+        }
+        hopPosition = 0;
+        for (auto& meter : meters) {
+            meter = {};
+        }
+        meteredFrames = 0;
+        startNewMeteringPeriod = false;
+    }
+
+    // Regroups the bins, into one of SPECTRAL_BAND_COUNTS spectral bands. The envelopes start over, so it isn't meant
+    // to be automated
+    void setNumSpectralBands(int newNumSpectralBands) {
+        jassert(std::find(SPECTRAL_BAND_COUNTS.begin(), SPECTRAL_BAND_COUNTS.end(), newNumSpectralBands) != SPECTRAL_BAND_COUNTS.end());
+        if (newNumSpectralBands == numSpectralBands) {
+            return;
+        }
+        numSpectralBands = newNumSpectralBands;
+        // before prepare() there are no layouts yet, it picks this one
+        if (bandLayouts.empty()) {
+            return;
+        }
+        bandLayout = &bandLayouts[getLayoutIndex(numSpectralBands)];
+        updateSpectralBandOwners();
+        for (auto& envelope : envelopes) {
+            envelope.fill(0.f);
+        }
+    }
+    int getNumSpectralBands() const { return numSpectralBands; }
+
+    // index 0 is the lowest crossover
+    void setCrossoverFrequency(int index, float frequency) {
+        jassert(juce::isPositiveAndBelow(index, NumBands - 1));
+        auto& cutoff = cutoffs[static_cast<size_t>(index)];
+        if (cutoff != frequency) {
+            cutoff = frequency;
+            updateCrossoverBins();
+        }
+    }
+
+    // Same settings as CompressorKernel::setBandParameters(), for a plugin band. Every spectral band centred in it
+    // follows them
+    void setBandParameters(int band, float attackMs, float releaseMs, float thresholdDb, float ratio, bool bypassed) {
+        jassert(juce::isPositiveAndBelow(band, NumBands));
+        jassert(ratio >= 1.f);
+        auto& settings = bandSettings[static_cast<size_t>(band)];
+        settings.attackCte = calculateCte(attackMs);
+        settings.releaseCte = calculateCte(releaseMs);
+        settings.thresholdLog2 = FastMath::log2(juce::Decibels::decibelsToGain(thresholdDb, -200.f));
+        // a bypassed band keeps following its envelope, but a zero slope means it never reduces gain
+        settings.slope = bypassed ? 0.f : (1.f / ratio) - 1.f;
+    }
+
+    // see CompressorKernel::setChannelLinks(), a group's channels follow the loudest of them in every spectral band
+    void setChannelLinks(const int* groups) {
+        std::copy(groups, groups + numChannels, linkGroups.begin());
+    }
+
+    void setChannelMeterWeights(const float* weights) {
+        std::copy(weights, weights + numChannels, meterWeights.begin());
+    }
+
+    // Starts a new metering period with the next frame, so a period too short for a frame to finish in still reads
+    // the last one's levels
+    void resetMeters() {
+        startNewMeteringPeriod = true;
+    }
+
+    // Levels of a plugin band's bins over the frames since resetMeters(), in the kernel's terms. RMS is the weighted
+    // mean power of the channels, peaks are the loudest frame's level (a steady sine reads its peak), and the
+    // minimum gain is the lowest any of the band's spectral bands applied
+    CompressorKernel::BandLevels getBandLevels(int band) const {
+        jassert(juce::isPositiveAndBelow(band, NumBands));
+        CompressorKernel::BandLevels levels;
+        if (meteredFrames == 0) {
+            return levels;
+        }
+        const auto& meter = meters[static_cast<size_t>(band)];
+        levels.inputRms = std::sqrt(meter.inputPower / static_cast<float>(meteredFrames));
+        levels.outputRms = std::sqrt(meter.outputPower / static_cast<float>(meteredFrames));
+        levels.inputPeak = std::sqrt(2.f * meter.inputPeakPower);
+        levels.outputPeak = std::sqrt(2.f * meter.outputPeakPower);
+        levels.minimumGain = meter.minimumGain;
+        return levels;
+    }
+
+    // bands[0] holds the input on entry, every band buffer must already be the same size as it. The bands come out
+    // already compressed. Bands that aren't needed are neither resynthesised nor written
+    template<typename SampleType>
+    void process(std::array<juce::AudioBuffer<SampleType>, NumBands>& bands, const std::array<bool, NumBands>& bandNeeded) {
+        auto& input = bands[0];
+        auto numSamples = input.getNumSamples();
+
+        for (int start = 0; start < numSamples;) {
+            auto chunk = juce::jmin(numSamples - start, HopSize - hopPosition);
+
+            // the newest hop of each frame sits at its end
+            for (int chan = 0; chan < numChannels; ++chan) {
+                copySamples(input.getReadPointer(chan, start), inputFrames.getWritePointer(chan, FrameSize - HopSize + hopPosition), chunk);
+            }
+            for (size_t band = 0; band < bands.size(); ++band) {
+                if (!bandNeeded[band]) {
+                    continue;
+                }
+                for (int chan = 0; chan < numChannels; ++chan) {
+                    copySamples(bandOutputs[band].getReadPointer(chan, hopPosition), bands[band].getWritePointer(chan, start), chunk);
+                }
+            }
+
+            hopPosition += chunk;
+            start += chunk;
+            if (hopPosition == HopSize) {
+                processFrame(bandNeeded);
+                hopPosition = 0;
+            }
+        }
+    }
+private:
+    struct BandSettings {
+        float attackCte{ 0.f };
+        float releaseCte{ 0.f };
+        float thresholdLog2{ 0.f };
+        float slope{ 0.f };
+    };
+
+    struct BandMeter {
+        float inputPower{ 0.f };
+        float outputPower{ 0.f };
+        float inputPeakPower{ 0.f };
+        float outputPeakPower{ 0.f };
+        float minimumGain{ 1.f };
+    };
+
+    using SpectralBandArray = std::array<float, MaxSpectralBands>;
+
+    double sampleRate{ 44100.0 };
+    int numChannels{ 0 };
+
+    juce::dsp::FFT fft{ SPECTRAL_FFT_ORDER };
+    std::vector<float> fftBuffer; // interleaved re/im
+    std::vector<float> window;
+    float overlapAddScale{ 1.f };
+    float powerScale{ 1.f };
+
+    // [chan][sample], the last FrameSize samples of input with the hop being filled at the end
+    juce::AudioBuffer<float> inputFrames;
+    // [chan][re/im interleaved], the current frame's spectrum of every channel
+    juce::AudioBuffer<float> spectra;
+    // [chan][sample] per plugin band, the overlap-add in progress. The first HopSize samples are complete
+    std::array<juce::AudioBuffer<float>, NumBands> bandOutputs;
+    int hopPosition{ 0 };
+
+    // how the bins are grouped into spectral bands, see calculateBandLayout()
+    struct BandLayout {
+        std::array<int, MaxSpectralBands + 1> firstBin{};
+        std::array<float, MaxSpectralBands> centreFrequency{};
+    };
+    int numSpectralBands{ SPECTRAL_BAND_COUNTS[SPECTRAL_BANDS_DEFAULT] };
+    std::vector<BandLayout> bandLayouts; // one for each of SPECTRAL_BAND_COUNTS
+    const BandLayout* bandLayout{ nullptr }; // the one for numSpectralBands
+
+    // plugin bands, cut at the crossovers
+    std::array<float, NumBands - 1> cutoffs{};
+    std::array<int, NumBands> pluginBandFirstBin{};
+    std::array<int, MaxSpectralBands> spectralBandOwner{}; // the plugin band each spectral band takes its settings from
+    std::array<BandSettings, NumBands> bandSettings{};
+
+    // per channel
+    std::array<SpectralBandArray, MAX_CHANNELS> envelopes{};
+    std::array<SpectralBandArray, MAX_CHANNELS> levels{};
+    std::array<int, MAX_CHANNELS> linkGroups{};
+    std::array<float, MAX_CHANNELS> meterWeights{};
+    std::array<float, NumBins> binGains{};
+
+    std::array<BandMeter, NumBands> meters{};
+    int meteredFrames{ 0 };
+    bool startNewMeteringPeriod{ false };
+
+    // juce::dsp::BallisticsFilter's time constant, once per hop instead of once per sample
+    float calculateCte(float timeMs) const {
+        if (timeMs < 1.0e-3f) {
+            return 0.f;
+        }
+        auto expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 * HopSize / sampleRate;
+        return static_cast<float>(std::exp(expFactor / timeMs));
+    }
+
+    static float hzToErb(float hz) { return 21.4f * std::log10(1.f + 0.00437f * hz); }
+    static float erbToHz(float erb) { return (std::pow(10.f, erb / 21.4f) - 1.f) / 0.00437f; }
+
+    float binToHz(float bin) const { return bin * static_cast<float>(sampleRate) / static_cast<float>(FrameSize); }
+
+    static size_t getLayoutIndex(int count) {
+        auto found = std::find(SPECTRAL_BAND_COUNTS.begin(), SPECTRAL_BAND_COUNTS.end(), count);
+        return found != SPECTRAL_BAND_COUNTS.end() ? static_cast<size_t>(std::distance(SPECTRAL_BAND_COUNTS.begin(), found)) : static_cast<size_t>(SPECTRAL_BANDS_DEFAULT);
+    }
+
+    void calculateBandLayout(BandLayout& layout, int count) const {
+        // Evenly spaced on the ERB scale from MIN_FREQ to Nyquist. At the bottom that is narrower than a bin, so every
+        // band takes at least one bin and the rest are left for the bands above. DC goes in with the lowest band
+        auto& firstBin = layout.firstBin;
+        auto lowest = hzToErb(MIN_FREQ);
+        auto step = (hzToErb(static_cast<float>(sampleRate / 2.0)) - lowest) / static_cast<float>(count);
+        firstBin[0] = 0;
+        for (int band = 1; band < count; ++band) {
+            auto edge = erbToHz(lowest + step * static_cast<float>(band));
+            auto bin = juce::roundToInt(edge * static_cast<float>(FrameSize) / static_cast<float>(sampleRate));
+            firstBin[static_cast<size_t>(band)] = juce::jlimit(firstBin[static_cast<size_t>(band - 1)] + MinBinsPerBand, NumBins - MinBinsPerBand * (count - band), bin);
+        }
+        firstBin[static_cast<size_t>(count)] = NumBins;
+
+        for (int band = 0; band < count; ++band) {
+            auto first = firstBin[static_cast<size_t>(band)];
+            auto last = firstBin[static_cast<size_t>(band + 1)] - 1;
+            layout.centreFrequency[static_cast<size_t>(band)] = binToHz(0.5f * static_cast<float>(first + last));
+        }
+    }
+
+    void updateCrossoverBins() {
+        pluginBandFirstBin[0] = 0;
+        for (int i = 0; i < NumBands - 1; ++i) {
+            auto bin = juce::roundToInt(cutoffs[static_cast<size_t>(i)] * static_cast<float>(FrameSize) / static_cast<float>(sampleRate));
+            pluginBandFirstBin[static_cast<size_t>(i + 1)] = juce::jlimit(pluginBandFirstBin[static_cast<size_t>(i)], NumBins, bin);
+        }
+        updateSpectralBandOwners();
+    }
+
+    void updateSpectralBandOwners() {
+        if (bandLayout == nullptr) {
+            return;
+        }
+        for (int band = 0; band < numSpectralBands; ++band) {
+            auto owner = 0;
+            while (owner < NumBands - 1 && bandLayout->centreFrequency[static_cast<size_t>(band)] >= cutoffs[static_cast<size_t>(owner)]) {
+                ++owner;
+            }
+            spectralBandOwner[static_cast<size_t>(band)] = owner;
+        }
+    }
+
+    template<typename Source, typename Dest>
+    static void copySamples(const Source* source, Dest* dest, int numSamples) {
+        std::transform(source, source + numSamples, dest, [](Source sample) { return static_cast<Dest>(sample); });
+    }
+
+    int getPluginBandEnd(size_t band) const {
+        return band + 1 < pluginBandFirstBin.size() ? pluginBandFirstBin[band + 1] : NumBins;
+    }
+
+    void processFrame(const std::array<bool, NumBands>& bandNeeded) {
+        if (startNewMeteringPeriod) {
+            for (auto& meter : meters) {
+                meter = {};
+            }
+            meteredFrames = 0;
+            startNewMeteringPeriod = false;
+        }
+
+        // Every channel's spectrum and band levels first, the links need all of them before any gain is computed
+        for (int chan = 0; chan < numChannels; ++chan) {
+            auto* frame = inputFrames.getWritePointer(chan);
+            for (int i = 0; i < FrameSize; ++i) {
+                fftBuffer[static_cast<size_t>(i)] = frame[i] * window[static_cast<size_t>(i)];
+            }
+            fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+            auto* spectrum = spectra.getWritePointer(chan);
+            std::copy(fftBuffer.begin(), fftBuffer.begin() + 2 * NumBins, spectrum);
+            std::copy(frame + HopSize, frame + FrameSize, frame);
+
+            // a steady sine reads its peak, as the kernel's envelope would
+            auto& level = levels[static_cast<size_t>(chan)];
+            const auto& bandFirstBin = bandLayout->firstBin;
+            for (int band = 0; band < numSpectralBands; ++band) {
+                auto power = 0.f;
+                auto first = juce::jmax(0, bandFirstBin[static_cast<size_t>(band)] - 1);
+                auto end = juce::jmin(NumBins, bandFirstBin[static_cast<size_t>(band + 1)] + 1);
+                for (int bin = first; bin < end; ++bin) {
+                    power += spectrum[2 * bin] * spectrum[2 * bin] + spectrum[2 * bin + 1] * spectrum[2 * bin + 1];
+                }
+                level[static_cast<size_t>(band)] = std::sqrt(2.f * powerScale * power);
+            }
+        }
+
+        // a group's leader is its lowest channel, so it has seen the whole group by the time it is copied back out
+        for (int chan = 0; chan < numChannels; ++chan) {
+            auto leader = static_cast<size_t>(linkGroups[static_cast<size_t>(chan)]);
+            if (leader != static_cast<size_t>(chan)) {
+                for (int band = 0; band < numSpectralBands; ++band) {
+                    auto& loudest = levels[leader][static_cast<size_t>(band)];
+                    loudest = juce::jmax(loudest, levels[static_cast<size_t>(chan)][static_cast<size_t>(band)]);
+                }
+            }
+        }
+        for (int chan = 0; chan < numChannels; ++chan) {
+            auto leader = static_cast<size_t>(linkGroups[static_cast<size_t>(chan)]);
+            if (leader != static_cast<size_t>(chan)) {
+                levels[static_cast<size_t>(chan)] = levels[leader];
+            }
+        }
+
+        std::array<float, NumBands> inputPower{}, outputPower{}, totalWeight{};
+        for (int chan = 0; chan < numChannels; ++chan) {
+            computeBandGains(chan);
+            auto* spectrum = spectra.getWritePointer(chan);
+            auto weight = meterWeights[static_cast<size_t>(chan)];
+
+            // the gains go straight onto the spectrum, metering each plugin band on the way
+            for (size_t band = 0; band < bandOutputs.size(); ++band) {
+                auto before = 0.f, after = 0.f;
+                for (int bin = pluginBandFirstBin[band]; bin < getPluginBandEnd(band); ++bin) {
+                    auto gain = binGains[static_cast<size_t>(bin)];
+                    auto power = spectrum[2 * bin] * spectrum[2 * bin] + spectrum[2 * bin + 1] * spectrum[2 * bin + 1];
+                    before += power;
+                    after += gain * gain * power;
+                    spectrum[2 * bin] *= gain;
+                    spectrum[2 * bin + 1] *= gain;
+                }
+                inputPower[band] += weight * powerScale * before;
+                outputPower[band] += weight * powerScale * after;
+                totalWeight[band] += weight;
+                auto& meter = meters[band];
+                meter.inputPeakPower = juce::jmax(meter.inputPeakPower, powerScale * before);
+                meter.outputPeakPower = juce::jmax(meter.outputPeakPower, powerScale * after);
+            }
+
+            for (size_t band = 0; band < bandOutputs.size(); ++band) {
+                auto* output = bandOutputs[band].getWritePointer(chan);
+                std::copy(output + HopSize, output + FrameSize, output);
+                std::fill(output + FrameSize - HopSize, output + FrameSize, 0.f);
+                if (!bandNeeded[band]) {
+                    // nothing stale is left behind for when it is needed again
+                    std::fill(output, output + FrameSize, 0.f);
+                    continue;
+                }
+
+                // only this band's bins, the rest of the spectrum is silence
+                std::fill(fftBuffer.begin(), fftBuffer.end(), 0.f);
+                auto first = pluginBandFirstBin[band];
+                std::copy(spectrum + 2 * first, spectrum + 2 * getPluginBandEnd(band), fftBuffer.begin() + 2 * first);
+                fft.performRealOnlyInverseTransform(fftBuffer.data());
+                for (int i = 0; i < FrameSize; ++i) {
+                    output[i] += fftBuffer[static_cast<size_t>(i)] * window[static_cast<size_t>(i)] * overlapAddScale;
+                }
+            }
+        }
+
+        for (size_t band = 0; band < meters.size(); ++band) {
+            if (totalWeight[band] > 0.f) {
+                meters[band].inputPower += inputPower[band] / totalWeight[band];
+                meters[band].outputPower += outputPower[band] / totalWeight[band];
+            }
+        }
+        ++meteredFrames;
+    }
+
+    // the kernel's envelope and gain computer once per hop, its gain going to every bin of the band
+    void computeBandGains(int chan) {
+        auto& envelope = envelopes[static_cast<size_t>(chan)];
+        const auto& level = levels[static_cast<size_t>(chan)];
+        const auto& bandFirstBin = bandLayout->firstBin;
+        for (int band = 0; band < numSpectralBands; ++band) {
+            auto owner = static_cast<size_t>(spectralBandOwner[static_cast<size_t>(band)]);
+            const auto& settings = bandSettings[owner];
+            auto& env = envelope[static_cast<size_t>(band)];
+            env = CompressorKernel::followEnvelope(env, level[static_cast<size_t>(band)], settings.attackCte, settings.releaseCte);
+
+            auto over = FastMath::log2(FastMath::atLeast(env, MINIMUM_LEVEL)) - settings.thresholdLog2;
+            auto gain = juce::jmin(1.f, FastMath::exp2(over * settings.slope));
+            auto& meter = meters[owner];
+            meter.minimumGain = juce::jmin(meter.minimumGain, gain);
+
+            std::fill(binGains.begin() + bandFirstBin[static_cast<size_t>(band)], binGains.begin() + bandFirstBin[static_cast<size_t>(band + 1)], gain);
+        }
+    }
+};
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    WorkerPool.cpp
+    Created: 19 Oct 2026 1:38:37am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "WorkerPool.h"
+#include "../Constants.h"
+
+WorkerPool::Worker::Worker(WorkerPool& ownerPool, int index) :
+    juce::Thread("SimpleMBComp Worker " + juce::String(index)),
+    pool(ownerPool) {}
+
+WorkerPool::Worker::~Worker() {
+    stopThread(-1);
+}
+
+void WorkerPool::Worker::run() {
+    juce::ScopedNoDenormals noDenormals;
+    auto seenGeneration = pool.generation.load(std::memory_order_acquire);
+
+    while (!threadShouldExit()) {
+        // spin for the next job first, sub-blocks follow each other closely
+        auto spins = 0;
+        auto jobGeneration = pool.generation.load(std::memory_order_acquire);
+        while (jobGeneration == seenGeneration && spins < WORKER_POOL_SPIN_ITERATIONS && !threadShouldExit()) {
+            ++spins;
+            jobGeneration = pool.generation.load(std::memory_order_acquire);
+        }
+
+        if (jobGeneration == seenGeneration) {
+            // Announce the sleep before looking one last time, so a job published in between either is seen here or
+            // finds a sleeper to signal. The timeout only covers stopping
+            isSleeping.store(true, std::memory_order_seq_cst);
+            pool.sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            if (pool.generation.load(std::memory_order_seq_cst) == seenGeneration && !threadShouldExit()) {
+                wakeUp.wait(WORKER_POOL_SLEEP_TIMEOUT_MS);
+            }
+            pool.sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+            isSleeping.store(false, std::memory_order_seq_cst);
+            continue;
+        }
+
+        seenGeneration = jobGeneration;
+        pool.work(jobGeneration);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::start(int numWorkers) {
+    stop();
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+        // the audio thread waits on them, so they run with its priority
+        workers.back()->startRealtimeThread(juce::Thread::RealtimeOptions{});
+    }
+}
+
+void WorkerPool::stop() {
+    for (auto& worker : workers) {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.signal();
+    }
+    workers.clear();
+}
+
+void WorkerPool::runParallel(int numItems, void* context, Invoke invoke) {
+    // the job goes out before the generation that announces it
+    auto jobGeneration = generation.load(std::memory_order_relaxed) + 1;
+    jobContext.store(context, std::memory_order_relaxed);
+    jobInvoke.store(invoke, std::memory_order_relaxed);
+    jobItems.store(numItems, std::memory_order_relaxed);
+    remainingItems.store(numItems, std::memory_order_relaxed);
+    claim.store(static_cast<juce::uint64>(jobGeneration) << 32, std::memory_order_release);
+    generation.store(jobGeneration, std::memory_order_seq_cst);
+
+    if (sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+        for (auto& worker : workers) {
+            if (worker->isSleeping.load(std::memory_order_seq_cst)) {
+                worker->wakeUp.signal();
+            }
+        }
+    }
+
+    work(jobGeneration);
+
+    // whatever is left is already running on a worker
+    auto spins = 0;
+    while (remainingItems.load(std::memory_order_acquire) > 0) {
+        if (++spins > WORKER_POOL_SPIN_ITERATIONS) {
+            juce::Thread::yield();
+        }
+    }
+}
+
+void WorkerPool::work(juce::uint32 jobGeneration) {
+    auto* context = jobContext.load(std::memory_order_relaxed);
+    auto invoke = jobInvoke.load(std::memory_order_relaxed);
+    auto numItems = jobItems.load(std::memory_order_relaxed);
+
+    auto current = claim.load(std::memory_order_acquire);
+    for (;;) {
+        // a newer job has started, everything read above may belong to another one
+        if (static_cast<juce::uint32>(current >> 32) != jobGeneration) {
+            return;
+        }
+        auto item = static_cast<int>(current & 0xffffffffu);
+        if (item >= numItems) {
+            return;
+        }
+        if (claim.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            invoke(context, item);
+            remainingItems.fetch_sub(1, std::memory_order_release);
+            current = claim.load(std::memory_order_acquire);
+        }
+    }
+}
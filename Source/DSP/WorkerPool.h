@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    WorkerPool.h
+    Created: 19 Oct 2026 1:38:37am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Shares independent work items out between the audio thread and a few real time worker threads, within one callback.
+// run() publishes a job. Every thread, the audio thread included, then claims items with an atomic increment until
+// none are left, so a thread that finishes early simply takes more of them. The audio thread waits for the last
+// item with a spin that yields after a while, it never takes a lock or sleeps.
+// Between jobs the workers spin for a short while, so the next sub-block finds them awake, then sleep on an event of
+// their own. Only a worker that went to sleep costs the audio thread a signal.
+// The item counter carries the job's generation, so a worker that wakes late can never claim an item of the next job.
+struct WorkerPool {
+    ~WorkerPool();
+
+    // message thread, while the audio thread isn't using the pool
+    void start(int numWorkers);
+    void stop();
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+    // Audio thread. Calls job(item) once for every item in [0, numItems) and returns once they have all finished.
+    // Items may run in any order and at the same time, so they must not share anything they write to.
+    // With no workers, or a single item, it just runs them in turn
+    template<typename Job>
+    void run(int numItems, Job&& job) {
+        if (workers.empty() || numItems <= 1) {
+            for (int item = 0; item < numItems; ++item) {
+                job(item);
+            }
+            return;
+        }
+        runParallel(numItems, &job, [](void* context, int item) { (*static_cast<std::remove_reference_t<Job>*>(context))(item); });
+    }
+private:
+    using Invoke = void (*)(void*, int);
+
+    struct Worker : juce::Thread {
+        Worker(WorkerPool& pool, int index);
+        ~Worker() override;
+        void run() override;
+
+        juce::WaitableEvent wakeUp;
+        std::atomic<bool> isSleeping{ false };
+    private:
+        WorkerPool& pool;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // generation in the top 32 bits, next item to claim in the bottom 32
+    std::atomic<juce::uint64> claim{ 0 };
+    std::atomic<juce::uint32> generation{ 0 };
+    std::atomic<void*> jobContext{ nullptr };
+    std::atomic<Invoke> jobInvoke{ nullptr };
+    std::atomic<int> jobItems{ 0 };
+    std::atomic<int> remainingItems{ 0 };
+
+    std::atomic<int> sleepingWorkers{ 0 };
+
+    void runParallel(int numItems, void* context, Invoke invoke);
+    // claims and runs items of the given generation until there are none left
+    void work(juce::uint32 jobGeneration);
+};
@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../DSP/FastMath.h"
 #include "../DSP/Fifo.h"
 
 //==============================================================================
@@ -47,7 +48,7 @@ struct AnalyzerPathGenerator {
 
             if (!std::isnan(y) && !std::isinf(y)) {
                 float binFreq = binNum * binWidth;
-                float normalizedBinX = juce::mapFromLog10(binFreq, 20.f, 20000.f);
+                float normalizedBinX = binMapper(binFreq);
                 int binX = std::floor(normalizedBinX * width);
                 p.lineTo(binX, y);
             }
@@ -64,4 +65,5 @@ struct AnalyzerPathGenerator {
     }
 private:
     Fifo<PathType> pathFifo;
+    FastMath::LogFrequencyMapper binMapper{ 20.f, 20000.f };
 };
@@ -42,39 +42,30 @@ CompressorBandControls::CompressorBandControls(juce::AudioProcessorValueTreeStat
     addAndMakeVisible(soloButton);
     addAndMakeVisible(muteButton);
 
-    lowBand.setName(LOW_BUTTON_LABEL);
-    lowBand.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
-    lowBand.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-    midBand.setName(MID_BUTTON_LABEL);
-    midBand.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
-    midBand.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-    highBand.setName(HIGH_BUTTON_LABEL);
-    highBand.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
-    highBand.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
-
-    lowBand.setRadioGroupId(1);
-    midBand.setRadioGroupId(1);
-    highBand.setRadioGroupId(1);
-
     auto buttonSwitcher = [safePtr = this->safePtr]() {
         if (auto* c = safePtr.getComponent()) {
             c->updateAttachments();
         }
     };
 
-    lowBand.onClick = buttonSwitcher;
-    midBand.onClick = buttonSwitcher;
-    highBand.onClick = buttonSwitcher;
+    for (size_t band = 0; band < bandSelectButtons.size(); ++band) {
+        auto& bandButton = bandSelectButtons[band];
+        bandButton.setName(Params::getBandName(static_cast<int>(band)));
+        bandButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::grey);
+        bandButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::black);
+        bandButton.setRadioGroupId(1);
+        bandButton.onClick = buttonSwitcher;
+    }
 
-    // make lowBand the default choice
-    lowBand.setToggleState(true, juce::NotificationType::dontSendNotification);
+    // make the low band the default choice
+    bandSelectButtons.front().setToggleState(true, juce::NotificationType::dontSendNotification);
     updateAttachments();
     updateSliderEnablements();
     updateBandSelectButtonStates();
 
-    addAndMakeVisible(lowBand);
-    addAndMakeVisible(midBand);
-    addAndMakeVisible(highBand);
+    for (auto& bandButton : bandSelectButtons) {
+        addAndMakeVisible(bandButton);
+    }
 }
 
 CompressorBandControls::~CompressorBandControls() {
@@ -90,11 +81,10 @@ void CompressorBandControls::buttonClicked(juce::Button* button) {
 }
 
 void CompressorBandControls::toggleAllBands(bool shouldBeBypassed) {
-    std::vector<Component*> bands{ &lowBand, &midBand, &highBand };
-    for (auto* band : bands) {
-        band->setColour(juce::TextButton::ColourIds::buttonOnColourId, shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) : juce::Colours::grey);
-        band->setColour(juce::TextButton::ColourIds::buttonColourId, shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) : juce::Colours::black);
-        band->repaint();
+    for (auto& band : bandSelectButtons) {
+        band.setColour(juce::TextButton::ColourIds::buttonOnColourId, shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) : juce::Colours::grey);
+        band.setColour(juce::TextButton::ColourIds::buttonColourId, shouldBeBypassed ? bypassButton.findColour(juce::TextButton::ColourIds::buttonOnColourId) : juce::Colours::black);
+        band.repaint();
     }
 }
 
@@ -122,31 +112,26 @@ void CompressorBandControls::refreshBandButtonColors(juce::Button& band, juce::B
 
 void CompressorBandControls::updateBandSelectButtonStates() {
     using namespace Params;
-    std::vector<std::array<Names, 3>> paramsToCheck{
-        {Names::SoloLowBand, Names::MuteLowBand, Names::BypassedLowBand},
-        {Names::SoloMidBand, Names::MuteMidBand, Names::BypassedMidBand},
-        {Names::SoloHighBand, Names::MuteHighBand, Names::BypassedHighBand}
-    };
-
-    const auto& params = GetParams();
-    auto paramHelper = [&params, this](const auto& name) {
-        return dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts, params, name));
-    };
-
-    for (size_t i = 0; i < paramsToCheck.size(); ++i) {
-        auto& list = paramsToCheck[i];
-        auto* bandButton = (i == 0) ? &lowBand :
-                           (i == 1) ? &midBand :
-                                      &highBand;
+    for (size_t i = 0; i < bandSelectButtons.size(); ++i) {
+        const auto band = static_cast<int>(i);
+        const std::array<juce::String, 3> names{
+            getBandParamName(BandParam::Solo, band),
+            getBandParamName(BandParam::Mute, band),
+            getBandParamName(BandParam::Bypassed, band)
+        };
+        auto paramHelper = [&names, this](size_t pos) {
+            return dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts, names, pos));
+        };
 
-        if (auto* solo = paramHelper(list[0]); solo->get()) {
-            refreshBandButtonColors(*bandButton, soloButton);
+        auto& bandButton = bandSelectButtons[i];
+        if (auto* solo = paramHelper(0); solo->get()) {
+            refreshBandButtonColors(bandButton, soloButton);
         }
-        else if (auto* mute = paramHelper(list[1]); mute->get()) {
-            refreshBandButtonColors(*bandButton, muteButton);
+        else if (auto* mute = paramHelper(1); mute->get()) {
+            refreshBandButtonColors(bandButton, muteButton);
         }
-        else if (auto* byp = paramHelper(list[2]); byp->get()) {
-            refreshBandButtonColors(*bandButton, bypassButton);
+        else if (auto* byp = paramHelper(2); byp->get()) {
+            refreshBandButtonColors(bandButton, bypassButton);
         }
     }
 }
@@ -200,7 +185,11 @@ void CompressorBandControls::resized() {
     };
 
     auto bandButtonControlBox = createBandButtonControlBox({ &bypassButton, &soloButton, &muteButton });
-    auto bandSelectControlBox = createBandButtonControlBox({ &lowBand, &midBand, &highBand });
+    std::vector<Component*> bandSelectButtonPtrs;
+    for (auto& bandButton : bandSelectButtons) {
+        bandSelectButtonPtrs.push_back(&bandButton);
+    }
+    auto bandSelectControlBox = createBandButtonControlBox(bandSelectButtonPtrs);
 
     FlexBox flexBox;
     flexBox.flexDirection = FlexBox::Direction::row;
@@ -226,63 +215,26 @@ void CompressorBandControls::resized() {
 }
 
 void CompressorBandControls::updateAttachments() {
-    enum BandType {
-        Low,
-        Mid,
-        High
-    };
-
-    BandType bandType = [this]() {
-        if (lowBand.getToggleState()) {
-            return BandType::Low;
-        }
-        if (midBand.getToggleState()) {
-            return BandType::Mid;
-        }
-        return BandType::High;
-    }();
+    auto selected = std::find_if(bandSelectButtons.begin(), bandSelectButtons.end(), [](const auto& bandButton) {
+        return bandButton.getToggleState();
+    });
+    if (selected == bandSelectButtons.end()) {
+        selected = bandSelectButtons.begin();
+    }
+    activeBand = &*selected;
+    const auto band = static_cast<int>(std::distance(bandSelectButtons.begin(), selected));
 
     using namespace Params;
-    std::vector<Names> names;
-
-    switch (bandType) {
-    case Low:
-        names = std::vector<Names>{
-            Names::AttackLowBand,
-            Names::ReleaseLowBand,
-            Names::ThresholdLowBand,
-            Names::RatioLowBand,
-            Names::MuteLowBand,
-            Names::SoloLowBand,
-            Names::BypassedLowBand
-        };
-        activeBand = &lowBand;
-        break;
-    case Mid:
-        names = std::vector<Names>{
-            Names::AttackMidBand,
-            Names::ReleaseMidBand,
-            Names::ThresholdMidBand,
-            Names::RatioMidBand,
-            Names::MuteMidBand,
-            Names::SoloMidBand,
-            Names::BypassedMidBand
-        };
-        activeBand = &midBand;
-        break;
-    case High:
-        names = std::vector<Names>{
-            Names::AttackHighBand,
-            Names::ReleaseHighBand,
-            Names::ThresholdHighBand,
-            Names::RatioHighBand,
-            Names::MuteHighBand,
-            Names::SoloHighBand,
-            Names::BypassedHighBand
-        };
-        activeBand = &highBand;
-        break;
-    }
+    // in Pos order
+    const std::vector<juce::String> names{
+        getBandParamName(BandParam::Attack, band),
+        getBandParamName(BandParam::Release, band),
+        getBandParamName(BandParam::Threshold, band),
+        getBandParamName(BandParam::Ratio, band),
+        getBandParamName(BandParam::Mute, band),
+        getBandParamName(BandParam::Solo, band),
+        getBandParamName(BandParam::Bypassed, band)
+    };
 
     enum Pos {
         Attack,
@@ -294,10 +246,8 @@ void CompressorBandControls::updateAttachments() {
         Bypass
     };
 
-    const auto& params = GetParams();
-
-    auto getParamHelper = [&params, &apvts = this->apvts, &names](const auto& pos) -> auto& {
-        return getParam(apvts, params, names.at(pos));
+    auto getParamHelper = [&apvts = this->apvts, &names](const auto& pos) -> auto& {
+        return getParam(apvts, names, static_cast<size_t>(pos));
     };
 
     // must reset attachments before we can make new ones
@@ -329,15 +279,15 @@ void CompressorBandControls::updateAttachments() {
     ratioSlider.labels.add({ 1.0f, juce::String(ratioParam->choices.getReference(ratioParam->choices.size() - 1).getIntValue()) + ":1" });
     ratioSlider.changeParam(ratioParam);
 
-    auto makeAttachmentHelper = [&params, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider) {
-        makeAttachment(attachment, apvts, params, name, slider);
+    auto makeAttachmentHelper = [&names, &apvts = this->apvts](auto& attachment, const auto& pos, auto& slider) {
+        makeAttachment(attachment, apvts, names, static_cast<size_t>(pos), slider);
     };
 
-    makeAttachmentHelper(attackSliderAttachment, names[Pos::Attack], attackSlider);
-    makeAttachmentHelper(releaseSliderAttachment, names[Pos::Release], releaseSlider);
-    makeAttachmentHelper(thresholdSliderAttachment, names[Pos::Threshold], thresholdSlider);
-    makeAttachmentHelper(ratioSliderAttachment, names[Pos::Ratio], ratioSlider);
-    makeAttachmentHelper(bypassButtonAttachment, names[Pos::Bypass], bypassButton);
-    makeAttachmentHelper(soloButtonAttachment, names[Pos::Solo], soloButton);
-    makeAttachmentHelper(muteButtonAttachment, names[Pos::Mute], muteButton);
+    makeAttachmentHelper(attackSliderAttachment, Pos::Attack, attackSlider);
+    makeAttachmentHelper(releaseSliderAttachment, Pos::Release, releaseSlider);
+    makeAttachmentHelper(thresholdSliderAttachment, Pos::Threshold, thresholdSlider);
+    makeAttachmentHelper(ratioSliderAttachment, Pos::Ratio, ratioSlider);
+    makeAttachmentHelper(bypassButtonAttachment, Pos::Bypass, bypassButton);
+    makeAttachmentHelper(soloButtonAttachment, Pos::Solo, soloButton);
+    makeAttachmentHelper(muteButtonAttachment, Pos::Mute, muteButton);
 }
\ No newline at end of file
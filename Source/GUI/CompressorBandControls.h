@@ -38,10 +38,11 @@ private:
         soloButtonAttachment,
         muteButtonAttachment;
 
-    juce::ToggleButton bypassButton, soloButton, muteButton, lowBand, midBand, highBand;
+    juce::ToggleButton bypassButton, soloButton, muteButton;
+    std::array<juce::ToggleButton, NUM_BANDS> bandSelectButtons; // lowest band first
     juce::Component::SafePointer<CompressorBandControls> safePtr{ this };
 
-    juce::ToggleButton* activeBand = &lowBand;
+    juce::ToggleButton* activeBand = &bandSelectButtons.front();
 
     void updateAttachments();
     void updateSliderEnablements();
@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "../DSP/SimdKernels.h"
 
 //==============================================================================
 // Fast Fourier Transform for converting audio buffer data into FastFourierTransform DataBlocks
@@ -33,26 +34,8 @@ struct FFTDataGenerator {
         forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());   // [2]
 
         int numBins = (int)fftSize / 2;
-        // TODO combine the below into the same for loop, probably makes no difference
-        //normalize the fft values
-        for (int i = 0; i < numBins; ++i) {
-            auto v = fftData[i];
-            if (!std::isinf(v) && !std::isnan(v)) {
-                v /= (float)numBins;
-            }
-            else {
-                v = 0.f;
-            }
-            fftData[i] = v;
-        }
-
-        float max = negativeInfinity;
-        //convert them to decibels
-        for (int i = 0; i < numBins; ++i) {
-            auto data = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-            fftData[i] = data;
-            max = juce::jmax(data, max);
-        }
+        //normalize the fft values and convert them to decibels, in one pass built for the processor's SimdPath
+        SimdKernels::magnitudesToDecibels(simdPath, fftData.data(), numBins, 1.f / (float)numBins, negativeInfinity);
 
         //jassertfalse;
 
@@ -74,6 +57,9 @@ struct FFTDataGenerator {
         fftDataFifo.prepare(fftData.size());
     }
 
+    // the instruction set to convert the bins with, see SimpleMBCompAudioProcessor::getSimdPath()
+    void setSimdPath(SimdPath newSimdPath) { simdPath = newSimdPath; }
+
     //==============================================================================
     int getFFtSize() const { return 1 << order; }
     int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
@@ -82,6 +68,7 @@ struct FFTDataGenerator {
 
 private:
     FFTOrder order;
+    SimdPath simdPath{ SimdPath::Baseline };
     BlockType fftData;
     std::unique_ptr<juce::dsp::FFT> forwardFFT;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
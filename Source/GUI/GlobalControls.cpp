@@ -13,6 +13,16 @@
 #include "../Constants.h"
 #include "Utilities.h"
 
+namespace {
+    // "LOW-MID X-OVER" and "MID-HI X-OVER" for three bands, shortened so the four and five band labels fit too
+    juce::String getXoverLabel(int index) {
+        auto shortName = [](int band) {
+            return Params::getBandName(band).toUpperCase().replace("HIGH", "HI").replace("LOW MID", "LO MID");
+        };
+        return shortName(index) + "-" + shortName(index + 1) + XOVER_LABEL_SUFFIX;
+    }
+}
+
 GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts) {
     using namespace Params;
     const auto& params = GetParams();
@@ -22,13 +32,9 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts) {
     };
 
     auto& gainInParam = getParamHelper(Names::GainIn);
-    auto& lowMidCrossoverParam = getParamHelper(Names::LowMidCrossoverFreq);
-    auto& midHighCrossoverParam = getParamHelper(Names::MidHighCrossoverFreq);
     auto& gainOutParam = getParamHelper(Names::GainOut);
 
     inGainSlider = std::make_unique<RSWL>(&gainInParam, DB, GAIN_IN_LABEL);
-    lowMidXoverSlider = std::make_unique<RSWL>(&lowMidCrossoverParam, HZ, LOW_MID_XOVER_LABEL);
-    midHighXoverSlider = std::make_unique<RSWL>(&midHighCrossoverParam, HZ, MID_HIGH_XOVER_LABEL);
     outGainSlider = std::make_unique<RSWL>(&gainOutParam, DB, GAIN_OUT_LABEL);
 
 
@@ -37,18 +43,27 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts) {
     };
 
     makeAttachmentHelper(inGainSliderAttachment, Names::GainIn, *inGainSlider);
-    makeAttachmentHelper(lowMidXoverSliderAttachment, Names::LowMidCrossoverFreq, *lowMidXoverSlider);
-    makeAttachmentHelper(midHighXoverSliderAttachment, Names::MidHighCrossoverFreq, *midHighXoverSlider);
     makeAttachmentHelper(outGainSliderAttachment, Names::GainOut, *outGainSlider);
 
     addLabelPairs(inGainSlider->labels, gainInParam, DB);
-    addLabelPairs(lowMidXoverSlider->labels, lowMidCrossoverParam, HZ);
-    addLabelPairs(midHighXoverSlider->labels, midHighCrossoverParam, HZ);
     addLabelPairs(outGainSlider->labels, gainOutParam, DB);
 
+    std::array<juce::String, NUM_BANDS - 1> xoverNames;
+    for (size_t i = 0; i < xoverNames.size(); ++i) {
+        xoverNames[i] = getCrossoverParamName(static_cast<int>(i));
+    }
+
+    for (size_t i = 0; i < xoverSliders.size(); ++i) {
+        auto& xoverParam = getParam(apvts, xoverNames, i);
+        xoverSliders[i] = std::make_unique<RSWL>(&xoverParam, HZ, getXoverLabel(static_cast<int>(i)));
+        makeAttachment(xoverSliderAttachments[i], apvts, xoverNames, i, *xoverSliders[i]);
+        addLabelPairs(xoverSliders[i]->labels, xoverParam, HZ);
+    }
+
     addAndMakeVisible(*inGainSlider);
-    addAndMakeVisible(*lowMidXoverSlider);
-    addAndMakeVisible(*midHighXoverSlider);
+    for (auto& xoverSlider : xoverSliders) {
+        addAndMakeVisible(*xoverSlider);
+    }
     addAndMakeVisible(*outGainSlider);
 }
 
@@ -70,10 +85,10 @@ void GlobalControls::resized() {
 
     flexBox.items.add(endCap);
     flexBox.items.add(FlexItem(*inGainSlider).withFlex(FLEX_DEFAULT));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(*lowMidXoverSlider).withFlex(FLEX_DEFAULT));
-    flexBox.items.add(spacer);
-    flexBox.items.add(FlexItem(*midHighXoverSlider).withFlex(FLEX_DEFAULT));
+    for (auto& xoverSlider : xoverSliders) {
+        flexBox.items.add(spacer);
+        flexBox.items.add(FlexItem(*xoverSlider).withFlex(FLEX_DEFAULT));
+    }
     flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(*outGainSlider).withFlex(FLEX_DEFAULT));
     flexBox.items.add(endCap);
@@ -20,10 +20,10 @@ struct GlobalControls : juce::Component {
 
 private:
     using RSWL = RotarySliderWithLabels;
-    std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider;
+    std::unique_ptr<RSWL> inGainSlider, outGainSlider;
+    std::array<std::unique_ptr<RSWL>, NUM_BANDS - 1> xoverSliders; // lowest crossover first
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    std::unique_ptr<Attachment> lowMidXoverSliderAttachment,
-        midHighXoverSliderAttachment,
-        inGainSliderAttachment,
+    std::unique_ptr<Attachment> inGainSliderAttachment,
         outGainSliderAttachment;
+    std::array<std::unique_ptr<Attachment>, NUM_BANDS - 1> xoverSliderAttachments;
 };
\ No newline at end of file
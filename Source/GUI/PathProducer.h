@@ -28,6 +28,7 @@ struct PathProducer {
     void process(juce::Rectangle<float> fftBounds, double sampleRate);
     juce::Path getPath() { return fftPath; }
     void updateNegativeInfinity(float nf) { negativeInfinity = nf; };
+    void updateSimdPath(SimdPath simdPath) { fftDataGenerator.setSimdPath(simdPath); }
 private:
     SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>* channelFifo;
     juce::AudioBuffer<float> monoBuffer;
@@ -11,6 +11,7 @@
 #include "SpectrumAnalyzer.h"
 #include "../Constants.h"
 #include "Utilities.h"
+#include "../DSP/FastMath.h"
 #include "../DSP/Params.h"
 
 //==============================================================================
@@ -23,19 +24,19 @@ SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
         param->addListener(this);
     }
     using namespace Params;
-    const auto& paramNames = GetParams();
-    
-    auto floatHelper = [&apvts = audioProcessor.apvts, &paramNames](auto& param, const auto& paramName) {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName)));
+
+    auto floatHelper = [&apvts = audioProcessor.apvts](auto& param, const auto& paramName) {
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
 
-    floatHelper(lowMidXoverParam, Names::LowMidCrossoverFreq);
-    floatHelper(midHighXoverParam, Names::MidHighCrossoverFreq);
+    for (size_t i = 0; i < xoverParams.size(); ++i) {
+        floatHelper(xoverParams[i], getCrossoverParamName(static_cast<int>(i)));
+    }
 
-    floatHelper(lowThresholdParam, Names::ThresholdLowBand);
-    floatHelper(midThresholdParam, Names::ThresholdMidBand);
-    floatHelper(highThresholdParam, Names::ThresholdHighBand);
+    for (size_t band = 0; band < thresholdParams.size(); ++band) {
+        floatHelper(thresholdParams[band], getBandParamName(BandParam::Threshold, static_cast<int>(band)));
+    }
 
     startTimerHz(60);
 }
@@ -58,6 +59,8 @@ void SpectrumAnalyzer::timerCallback() {
         fftBounds.setBottom(bounds.getBottom());
         double sampleRate = audioProcessor.getSampleRate();
 
+        leftPathProducer.updateSimdPath(audioProcessor.getSimdPath());
+        rightPathProducer.updateSimdPath(audioProcessor.getSimdPath());
         leftPathProducer.process(fftBounds, sampleRate);
         rightPathProducer.process(fftBounds, sampleRate);
     }
@@ -207,10 +210,10 @@ std::vector<float> SpectrumAnalyzer::getGains() {
 }
 
 std::vector<float> SpectrumAnalyzer::getXs(const std::vector<float>& freqs, float left, float width) {
-    std::vector<float> xs;
-    for (auto f : freqs) {
-        auto normX = juce::mapFromLog10(f, MIN_FREQ, MAX_FREQ);
-        xs.push_back(left + width * normX);
+    std::vector<float> xs(freqs.size());
+    FastMath::LogFrequencyMapper(MIN_FREQ, MAX_FREQ).map(freqs.data(), xs.data(), static_cast<int>(xs.size()));
+    for (auto& x : xs) {
+        x = left + width * x;
     }
 
     return xs;
@@ -263,8 +266,8 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bo
     const auto left = bounds.getX();
     const auto right = bounds.getRight();
 
-    auto mapX = [left = bounds.getX(), width = bounds.getWidth()](float frequency) {
-        auto normX = mapFromLog10(frequency, MIN_FREQ, MAX_FREQ);
+    auto mapX = [left = bounds.getX(), width = bounds.getWidth(), mapper = FastMath::LogFrequencyMapper(MIN_FREQ, MAX_FREQ)](float frequency) {
+        auto normX = mapper(frequency);
         return left + width * normX;
     };
 
@@ -272,38 +275,34 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bo
         return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, float(bottom), (float)top);
     };
 
-    auto lowMidX = mapX(lowMidXoverParam->get());
-    auto midHighX = mapX(midHighXoverParam->get());
+    // band i spans edges i to i + 1, the outer edges are the sides of the analysis area
+    std::array<float, NUM_BANDS + 1> edges;
+    edges.front() = static_cast<float>(left);
+    edges.back() = static_cast<float>(right);
     g.setColour(Colours::orange);
-    g.drawVerticalLine(lowMidX, top, bottom);
-    g.drawVerticalLine(midHighX, top, bottom);
+    for (size_t i = 0; i < xoverParams.size(); ++i) {
+        edges[i + 1] = mapX(xoverParams[i]->get());
+        g.drawVerticalLine(static_cast<int>(edges[i + 1]), top, bottom);
+    }
 
     auto zeroDb = mapY(0.f);
     g.setColour(Colours::hotpink.withAlpha(0.3f));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowMidX, mapY(lowBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowMidX, zeroDb, midHighX, mapY(midBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midHighX, zeroDb, right, mapY(highBandGR)));
+    for (size_t band = 0; band < bandGR.size(); ++band) {
+        g.fillRect(Rectangle<float>::leftTopRightBottom(edges[band], zeroDb, edges[band + 1], mapY(bandGR[band])));
+    }
 
     g.setColour(Colours::yellow);
-    g.drawHorizontalLine(mapY(lowThresholdParam->get()), left, lowMidX);
-    g.drawHorizontalLine(mapY(midThresholdParam->get()), lowMidX, midHighX);
-    g.drawHorizontalLine(mapY(highThresholdParam->get()), midHighX, right);
+    for (size_t band = 0; band < thresholdParams.size(); ++band) {
+        g.drawHorizontalLine(static_cast<int>(mapY(thresholdParams[band]->get())), edges[band], edges[band + 1]);
+    }
 }
 
-void SpectrumAnalyzer::update(const std::vector<float>& values) {
-    jassert(values.size() == 6);
-    enum {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
-    };
-
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
+void SpectrumAnalyzer::update(const std::vector<CompressorBand::MeterSnapshot>& values) {
+    jassert(values.size() == bandGR.size());
+    // the gain the compressors actually took off at their deepest point in the block
+    for (size_t band = 0; band < bandGR.size(); ++band) {
+        bandGR[band] = values[band].gainReductionPeakDb;
+    }
 
     repaint();
 }
\ No newline at end of file
@@ -31,7 +31,7 @@ public:
         shouldShowFFTAnlaysis = enabled;
     }
 
-    void update(const std::vector<float>& values);
+    void update(const std::vector<CompressorBand::MeterSnapshot>& values);
 private:
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
@@ -56,13 +56,9 @@ private:
     void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
     void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
 
-    juce::AudioParameterFloat* lowMidXoverParam{ nullptr };
-    juce::AudioParameterFloat* midHighXoverParam{ nullptr };
-    juce::AudioParameterFloat* lowThresholdParam{ nullptr };
-    juce::AudioParameterFloat* midThresholdParam{ nullptr };
-    juce::AudioParameterFloat* highThresholdParam{ nullptr };
+    // lowest first
+    std::array<juce::AudioParameterFloat*, NUM_BANDS - 1> xoverParams{};
+    std::array<juce::AudioParameterFloat*, NUM_BANDS> thresholdParams{};
 
-    float lowBandGR{ 0.f };
-    float midBandGR{ 0.f };
-    float highBandGR{ 0.f };
+    std::array<float, NUM_BANDS> bandGR{};
 };
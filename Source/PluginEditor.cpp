@@ -30,7 +30,7 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
     addAndMakeVisible(globalControls);
     addAndMakeVisible(bandControls);
 
-    setSize (600, 500);
+    setSize (EDITOR_WIDTH, EDITOR_HEIGHT);
     startTimerHz(60);
 }
 
@@ -59,61 +59,42 @@ void SimpleMBCompAudioProcessorEditor::resized()
 }
 
 void SimpleMBCompAudioProcessorEditor::timerCallback() {
-    std::vector<float> values{
-        audioProcessor.lowBandComp.getRmsInputLevelDb(),
-        audioProcessor.lowBandComp.getRmsOutputLevelDb(),
-        audioProcessor.midBandComp.getRmsInputLevelDb(),
-        audioProcessor.midBandComp.getRmsOutputLevelDb(),
-        audioProcessor.highBandComp.getRmsInputLevelDb(),
-        audioProcessor.highBandComp.getRmsOutputLevelDb(),
-    };
+    std::vector<CompressorBand::MeterSnapshot> values;
+    for (const auto& comp : audioProcessor.compressors) {
+        values.push_back(comp.getMeterSnapshot());
+    }
 
     analyzer.update(values);
     updateGlobalBypassButton();
 }
 
 void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState() {
-    bool shouldEnableEverything = !controlBar.globalBypassButton.getToggleState();
-    auto params = getBypassParams();
+    // the processor's own bypass, the band settings are left alone so they come back exactly as they were
+    bool shouldBeBypassed = controlBar.globalBypassButton.getToggleState();
+    auto* param = getGlobalBypassParam();
 
-    auto bypassParamHelper = [](auto* param, bool shouldBeBypassed) {
-        param->beginChangeGesture();
-        param->setValueNotifyingHost(shouldBeBypassed ? 1.f : 0.f);
-        param->endChangeGesture();
-    };
+    param->beginChangeGesture();
+    param->setValueNotifyingHost(shouldBeBypassed ? 1.f : 0.f);
+    param->endChangeGesture();
 
-    for (auto* param : params) {
-        bypassParamHelper(param, !shouldEnableEverything);
-    }
-    bandControls.toggleAllBands(!shouldEnableEverything);
+    bandControls.toggleAllBands(shouldBeBypassed);
 }
 
-std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams() {
+juce::AudioParameterBool* SimpleMBCompAudioProcessorEditor::getGlobalBypassParam() {
     using namespace Params;
-    using namespace juce;
     const auto& params = GetParams();
-    auto& apvts = audioProcessor.apvts;
 
-    auto boolHelper = [&apvts, &params](const auto& paramName) {
-        auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
+    auto param = dynamic_cast<juce::AudioParameterBool*>(audioProcessor.apvts.getParameter(params.at(Names::GlobalBypass)));
+    jassert(param != nullptr);
 
-        return param;
-    };
-
-    auto* lowBypassParam = boolHelper(Names::BypassedLowBand);
-    auto* midBypassParam = boolHelper(Names::BypassedMidBand);
-    auto* highBypassParam = boolHelper(Names::BypassedHighBand);
-
-    return {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
-    };
+    return param;
 }
 
 void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton() {
-    auto params = getBypassParams();
-    bool allBandsAreBypassed = std::all_of(params.begin(), params.end(), [](const auto& param) {return param->get(); });
-    controlBar.globalBypassButton.setToggleState(allBandsAreBypassed, juce::NotificationType::dontSendNotification);
+    // the host can bypass through the same parameter, so the button follows it rather than the other way round
+    bool isBypassed = getGlobalBypassParam()->get();
+    if (controlBar.globalBypassButton.getToggleState() != isBypassed) {
+        controlBar.globalBypassButton.setToggleState(isBypassed, juce::NotificationType::dontSendNotification);
+        bandControls.toggleAllBands(isBypassed);
+    }
 }
@@ -41,7 +41,7 @@ private:
     ControlBar controlBar;
 
     void toggleGlobalBypassState();
-    std::array<juce::AudioParameterBool*, 3> getBypassParams();
+    juce::AudioParameterBool* getGlobalBypassParam();
     void updateGlobalBypassButton();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
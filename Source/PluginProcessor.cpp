@@ -9,82 +9,136 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "DSP/Params.h"
+#include "DSP/SimdKernels.h"
 
 //==============================================================================
-SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
+namespace {
+    juce::AudioProcessor::BusesProperties createBusesProperties() {
+        auto buses = juce::AudioProcessor::BusesProperties()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
-                       )
+                       ;
+       #if ! JucePlugin_IsMidiEffect
+        // one output per band after the main one, carrying that band on its own. Off until the host enables them
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            buses = buses.withOutput(Params::getBandName(band) + " Band", juce::AudioChannelSet::stereo(), false);
+        }
+       #endif
+        return buses;
+    }
+}
+#endif
+
+SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (createBusesProperties())
 #endif
 {
     using namespace Params;
     const auto& params = GetParams();
 
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName) {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
+    auto floatHelper = [&apvts = this->apvts](auto& param, const juce::String& paramName) {
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
 
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName) {
-        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
+    auto choiceHelper = [&apvts = this->apvts](auto& param, const juce::String& paramName) {
+        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
 
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName) {
-        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
+    auto boolHelper = [&apvts = this->apvts](auto& param, const juce::String& paramName) {
+        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(paramName));
         jassert(param != nullptr);
     };
 
-    floatHelper(lowBandComp.attack, Names::AttackLowBand);
-    floatHelper(lowBandComp.release, Names::ReleaseLowBand);
-    floatHelper(lowBandComp.threshold, Names::ThresholdLowBand);
-    choiceHelper(lowBandComp.ratio, Names::RatioLowBand);
-    boolHelper(lowBandComp.bypassed, Names::BypassedLowBand);
-    boolHelper(lowBandComp.mute, Names::MuteLowBand);
-    boolHelper(lowBandComp.solo, Names::SoloLowBand);
-
-    floatHelper(midBandComp.attack, Names::AttackMidBand);
-    floatHelper(midBandComp.release, Names::ReleaseMidBand);
-    floatHelper(midBandComp.threshold, Names::ThresholdMidBand);
-    choiceHelper(midBandComp.ratio, Names::RatioMidBand);
-    boolHelper(midBandComp.bypassed, Names::BypassedMidBand);
-    boolHelper(midBandComp.mute, Names::MuteMidBand);
-    boolHelper(midBandComp.solo, Names::SoloMidBand);
-
-    floatHelper(highBandComp.attack, Names::AttackHighBand);
-    floatHelper(highBandComp.release, Names::ReleaseHighBand);
-    floatHelper(highBandComp.threshold, Names::ThresholdHighBand);
-    choiceHelper(highBandComp.ratio, Names::RatioHighBand);
-    boolHelper(highBandComp.bypassed, Names::BypassedHighBand);
-    boolHelper(highBandComp.mute, Names::MuteHighBand);
-    boolHelper(highBandComp.solo, Names::SoloHighBand);
-
-    floatHelper(lowMidCrossover, Names::LowMidCrossoverFreq);
-    floatHelper(midHighCrossover, Names::MidHighCrossoverFreq);
-
-    floatHelper(inputGainParam, Names::GainIn);
-    floatHelper(outputGainParam, Names::GainOut);
-
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-
-    //invAP1.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-    //invAP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        auto& comp = compressors[static_cast<size_t>(band)];
+        floatHelper(comp.attack, getBandParamName(BandParam::Attack, band));
+        floatHelper(comp.release, getBandParamName(BandParam::Release, band));
+        floatHelper(comp.threshold, getBandParamName(BandParam::Threshold, band));
+        choiceHelper(comp.ratio, getBandParamName(BandParam::Ratio, band));
+        boolHelper(comp.bypassed, getBandParamName(BandParam::Bypassed, band));
+        boolHelper(comp.mute, getBandParamName(BandParam::Mute, band));
+        boolHelper(comp.solo, getBandParamName(BandParam::Solo, band));
+        floatHelper(comp.lookahead, getBandParamName(BandParam::Lookahead, band));
+        choiceHelper(comp.oversampling, getBandParamName(BandParam::Oversampling, band));
+        choiceHelper(comp.controlRate, getBandParamName(BandParam::ControlRate, band));
+    }
+
+    for (size_t i = 0; i < crossoverFreqs.size(); ++i) {
+        floatHelper(crossoverFreqs[i], getCrossoverParamName(static_cast<int>(i)));
+        choiceHelper(crossoverSlopes[i], getCrossoverSlopeParamName(static_cast<int>(i)));
+    }
+
+    floatHelper(inputGainParam, params.at(Names::GainIn));
+    floatHelper(outputGainParam, params.at(Names::GainOut));
+
+    boolHelper(globalBypass, params.at(Names::GlobalBypass));
+    choiceHelper(crossoverModeParam, params.at(Names::CrossoverMode));
+    choiceHelper(oversamplingFilterParam, params.at(Names::OversamplingFilter));
+    choiceHelper(channelLinkParam, params.at(Names::ChannelLink));
+    choiceHelper(spectralBandsParam, params.at(Names::SpectralBands));
+
+    builder.addJob([this] { linearPhaseCrossover.buildPendingKernels(); });
 }
 
 SimpleMBCompAudioProcessor::~SimpleMBCompAudioProcessor()
 {
 }
 
+template<>
+SimpleMBCompAudioProcessor::SamplePath<float>& SimpleMBCompAudioProcessor::getPath<float>() {
+    return floatPath;
+}
+
+template<>
+SimpleMBCompAudioProcessor::SamplePath<double>& SimpleMBCompAudioProcessor::getPath<double>() {
+    return doublePath;
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::SamplePath<SampleType>::prepare(const juce::dsp::ProcessSpec& spec, int multirateLatency, int maxBypassDelay, int pipelineLatency) {
+    for (auto& delay : multirateDelays) {
+        delay.prepare(spec);
+        delay.setMaximumDelayInSamples(juce::jmax(1, multirateLatency));
+        delay.setDelay(static_cast<SampleType>(multirateLatency));
+    }
+    bypassDelay.prepare(spec);
+    bypassDelay.setMaximumDelayInSamples(maxBypassDelay);
+
+    crossover.prepare(spec);
+    complementaryCrossover.prepare(spec);
+    for (auto& allpass : bypassAllpasses) {
+        allpass.prepare(spec);
+    }
+
+    auto numChannels = static_cast<int>(spec.numChannels);
+    auto numSamples = static_cast<int>(spec.maximumBlockSize);
+    bypassBuffer.setSize(numChannels, numSamples);
+    pipeline.prepare(numChannels, pipelineLatency);
+    // the pipeline holds the bands itself when there is one
+    bandArena.prepare(numChannels, pipelineLatency > 0 ? 0 : numSamples);
+    bandArena.referTo(filterBuffers, 0, bandArena.getNumSamples());
+
+    inputGain.prepare(spec);
+    outputGain.prepare(spec);
+
+    inputGain.setRampDurationSeconds(0.05); // 50 ms
+    outputGain.setRampDurationSeconds(0.05);
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::SamplePath<SampleType>::resetCrossovers() {
+    crossover.reset();
+    complementaryCrossover.reset();
+}
+
 //==============================================================================
 const juce::String SimpleMBCompAudioProcessor::getName() const
 {
@@ -120,7 +174,7 @@ bool SimpleMBCompAudioProcessor::isMidiEffect() const
 
 double SimpleMBCompAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds.load();
 }
 
 int SimpleMBCompAudioProcessor::getNumPrograms()
@@ -148,41 +202,141 @@ void SimpleMBCompAudioProcessor::changeProgramName (int index, const juce::Strin
 }
 
 //==============================================================================
+void SimpleMBCompAudioProcessor::setSubBlockSize(int numSamples) {
+    subBlockSize = juce::jlimit(SUB_BLOCK_SIZE_MIN, SUB_BLOCK_SIZE_MAX, numSamples);
+}
+
+void SimpleMBCompAudioProcessor::setNumWorkerThreads(int numThreads) {
+    numWorkerThreads = numThreads == WORKER_THREADS_AUTOMATIC ? numThreads : juce::jlimit(0, WORKER_THREADS_MAX, numThreads);
+}
+
+void SimpleMBCompAudioProcessor::setPipelined(bool shouldBePipelined) {
+    shouldPipeline = shouldBePipelined;
+}
+
+void SimpleMBCompAudioProcessor::setSimdPath(SimdPath path) {
+    requestedSimdPath = path;
+}
+
 void SimpleMBCompAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+    // nothing below can be rebuilt while the builder is reading it
+    builder.stopThread(-1);
+
+    // everything below is sized for one internal sub-block, processBlock never hands the engine more than that
+    preparedSubBlockSize = subBlockSize;
+
     juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getTotalNumOutputChannels();
+    spec.maximumBlockSize = static_cast<juce::uint32>(preparedSubBlockSize);
+    spec.numChannels = static_cast<juce::uint32>(getMainBusNumOutputChannels());
     spec.sampleRate = sampleRate;
 
-    // passing compressors by reference for preparation
-    for (auto& comp : compressors) {
-        comp.prepare(spec);
+    // At high sample rates the low band runs decimated on its own kernel, the rest share the fused one
+    lowBandResampler.prepare(sampleRate, preparedSubBlockSize, static_cast<int>(spec.numChannels));
+    firstFusedBand = lowBandResampler.isActive() ? 1 : 0;
+    for (auto& oversampler : bandOversamplers) {
+        oversampler.prepare(sampleRate, preparedSubBlockSize, static_cast<int>(spec.numChannels), isUsingDoublePrecision());
+    }
+    auto maxBandDelay = getMaxBandDelaySamples();
+    lowBandKernel.prepare(lowBandResampler.getReducedSampleRate(), 1, static_cast<int>(spec.numChannels), maxBandDelay / lowBandResampler.getFactor());
+    compressorKernel.prepare(sampleRate, static_cast<int>(compressors.size() - firstFusedBand), static_cast<int>(spec.numChannels), maxBandDelay);
+    for (auto& oversampler : bandOversamplers) {
+        oversampler.prepareKernels(maxBandDelay);
+    }
+    for (size_t i = 0; i < crossoverFreqs.size(); ++i) {
+        spectralCompressor.setCrossoverFrequency(static_cast<int>(i), crossoverFreqs[i]->get());
+    }
+    spectralCompressor.setNumSpectralBands(getNumSpectralBandsParam());
+    spectralCompressor.prepare(spec);
+
+    // The instruction set is picked once here, for every kernel, rather than checked per block
+    auto simdPath = SimdDispatch::resolve(requestedSimdPath);
+    activeSimdPath.store(simdPath, std::memory_order_relaxed);
+    compressorKernel.setSimdPath(simdPath);
+    lowBandKernel.setSimdPath(simdPath);
+    for (auto& oversampler : bandOversamplers) {
+        oversampler.setSimdPath(simdPath);
     }
 
-    LP1.prepare(spec);
-    LP2.prepare(spec);
-    HP1.prepare(spec); 
-    HP2.prepare(spec);
-    AP2.prepare(spec);
-
-    // null test all pass
-    //invAP1.prepare(spec);
-    //invAP2.prepare(spec);
-    //invAPBuffer.setSize(spec.numChannels, samplesPerBlock);
+    // every buffer above and below is sized for the layout's channel count here, nothing grows on the audio thread
+    channelLayout.prepare(getChannelLayoutOfBus(false, 0));
+    for (size_t band = 0; band < bandOutputIsEnabled.size(); ++band) {
+        const auto* bus = getBus(false, static_cast<int>(band) + 1);
+        bandOutputIsEnabled[band] = bus != nullptr && bus->isEnabled();
+    }
+    const auto* meterWeights = channelLayout.getMeterWeights().data();
+    compressorKernel.setChannelMeterWeights(meterWeights);
+    lowBandKernel.setChannelMeterWeights(meterWeights);
+    spectralCompressor.setChannelMeterWeights(meterWeights);
+    for (auto& oversampler : bandOversamplers) {
+        oversampler.setChannelMeterWeights(meterWeights);
+    }
+    updateChannelLinks(true);
 
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
+    // Wide layouts get a few threads to share the channels and kernels with. Mono and stereo have too little to
+    // share for the synchronisation to pay off
+    auto numWorkers = numWorkerThreads;
+    if (numWorkers == WORKER_THREADS_AUTOMATIC) {
+        numWorkers = spec.numChannels > 2 ? juce::jlimit(0, WORKER_THREADS_MAX, juce::SystemStats::getNumCpus() - 1) : 0;
+    }
+    workerPool.start(numWorkers);
 
-    inputGain.setRampDurationSeconds(0.05); // 50 ms
-    outputGain.setRampDurationSeconds(0.05);
+    // A pipelined sub-block is compressed one full sub-block after it was split, however long it is
+    pipelineLatency = shouldPipeline ? preparedSubBlockSize : 0;
+    if (shouldPipeline) {
+        pipelineThread.start();
+    }
+    else {
+        pipelineThread.stop();
+    }
 
-    for (auto& buffer : filterBuffers) {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
+    // the bypass path matches whatever the latency is, which the linear phase crossover or the spectral engine adds to
+    auto multirateLatency = lowBandResampler.getLatencySamples();
+    auto maxModeLatency = juce::jmax(LinearPhaseCrossover<NUM_BANDS>::getLatencySamples(), SpectralCompressor<NUM_BANDS>::getLatencySamples());
+    auto maxBypassDelay = multirateLatency + maxModeLatency + maxBandDelay + pipelineLatency;
+    // the host picks the precision before preparing, only the path it will use needs any memory
+    if (isUsingDoublePrecision()) {
+        doublePath.prepare(spec, multirateLatency, maxBypassDelay, pipelineLatency);
+    }
+    else {
+        floatPath.prepare(spec, multirateLatency, maxBypassDelay, pipelineLatency);
     }
 
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    // the first kernels are designed right here, for the current settings
+    for (size_t i = 0; i < crossoverFreqs.size(); ++i) {
+        linearPhaseCrossover.setSlope(static_cast<int>(i), getCrossoverSlope(i));
+        linearPhaseCrossover.setCutoffFrequency(static_cast<int>(i), crossoverFreqs[i]->get());
+    }
+    linearPhaseCrossover.prepare(spec);
+    crossoverMode = getCrossoverModeParam();
+    updateOversampling();
+    bandDelaySamples = 0;
+    updateBandDelays();
+    updateLatency();
+    // the host can ask for the tail before the first block
+    tailLengthSeconds.store(calculateTailLengthSeconds());
+
+
+    bypassMix.reset(sampleRate, BYPASS_FADE_SECONDS);
+    bypassMix.setCurrentAndTargetValue(globalBypass->get() ? 1.f : 0.f);
+    mainPathIsWarm = true;
+    bypassPathIsWarm = false;
+    silentSamples = 0;
+
+    for (auto& bandGain : bandGains) {
+        bandGain.reset(sampleRate, BAND_FADE_SECONDS);
+        bandGain.setCurrentAndTargetValue(1.f);
+    }
+    bandIsActive.fill(true);
+    bandNeedsFilters.fill(true);
+
+    // The analyzer takes the signal one sample at a time, so host blocks of any size are fine, this only sets how often
+    // it gets a new chunk. Some hosts report a block size of 0 here
+    auto analyzerChunkSize = juce::jmax(samplesPerBlock, SUB_BLOCK_SIZE_MIN);
+    channelLayout.configureAnalyzerTap(leftChannelFifo, Channel::Left);
+    channelLayout.configureAnalyzerTap(rightChannelFifo, Channel::Right);
+    leftChannelFifo.prepare(analyzerChunkSize);
+    rightChannelFifo.prepare(analyzerChunkSize);
     
     osc.initialise([](float x) { return std::sin(x); });
     osc.prepare(spec);
@@ -190,12 +344,17 @@ void SimpleMBCompAudioProcessor::prepareToPlay(double sampleRate, int samplesPer
     osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50);
     gain.prepare(spec);
     gain.setGainDecibels(-24.f);
+
+    builder.startThread();
 }
 
 void SimpleMBCompAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    builder.stopThread(-1);
+    workerPool.stop();
+    pipelineThread.stop();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -206,11 +365,10 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     return true;
   #else
     // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
+    // Mono, stereo, 5.1, 7.1 and 7.1.4, see ChannelLayout.
     // Some plugin hosts, such as certain GarageBand versions, will only
     // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    if (!ChannelLayout::isSupported(layouts.getMainOutputChannelSet()))
         return false;
 
     // This checks if the input layout matches the output layout
@@ -219,62 +377,515 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
         return false;
    #endif
 
+    // and every band output is either off or laid out like the main one
+    for (int bus = 1; bus < layouts.outputBuses.size(); ++bus) {
+        auto bandLayout = layouts.getChannelSet(false, bus);
+        if (!bandLayout.isDisabled() && bandLayout != layouts.getMainOutputChannelSet())
+            return false;
+    }
+
     return true;
   #endif
 }
 #endif
 
+template<typename SampleType>
 void SimpleMBCompAudioProcessor::updateState() {
-    for (auto& compressor : compressors) {
-        compressor.updateCompressorSettings();
+    auto& path = getPath<SampleType>();
+    for (size_t i = 0; i < compressors.size(); ++i) {
+        auto [kernel, index] = getBandKernel(i);
+        compressors[i].updateCompressorSettings(*kernel, index);
+        if (crossoverMode == CrossoverMode::Spectral) {
+            compressors[i].updateCompressorSettings(spectralCompressor, static_cast<int>(i));
+        }
+    }
+    if (crossoverMode == CrossoverMode::Spectral) {
+        spectralCompressor.setNumSpectralBands(getNumSpectralBandsParam());
     }
 
-    auto lowMidCutoff = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoff);
-    HP1.setCutoffFrequency(lowMidCutoff);
-    //invAP1.setCutoffFrequency(lowMidCutoff);
+    // a new slope restarts that crossover's filters, the steeper slopes run on separately compiled code
+    for (size_t i = 0; i < crossoverFreqs.size(); ++i) {
+        auto cutoff = crossoverFreqs[i]->get();
+        auto slope = getCrossoverSlope(i);
+        if (crossoverMode == CrossoverMode::Complementary) {
+            path.complementaryCrossover.setSlope(static_cast<int>(i), slope);
+            path.complementaryCrossover.setCutoffFrequency(static_cast<int>(i), cutoff);
+        }
+        else if (crossoverMode == CrossoverMode::LinearPhase) {
+            // only records the change, the builder thread designs the kernels and they are crossfaded in
+            linearPhaseCrossover.setSlope(static_cast<int>(i), slope);
+            linearPhaseCrossover.setCutoffFrequency(static_cast<int>(i), cutoff);
+        }
+        else if (crossoverMode == CrossoverMode::Spectral) {
+            // cut between bins, so the slope doesn't apply
+            spectralCompressor.setCrossoverFrequency(static_cast<int>(i), cutoff);
+        }
+        else {
+            path.crossover.setSlope(static_cast<int>(i), slope);
+            path.crossover.setCutoffFrequency(static_cast<int>(i), cutoff);
+        }
+    }
 
-    auto midHighCutoff = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoff);
-    LP2.setCutoffFrequency(midHighCutoff);
-    HP2.setCutoffFrequency(midHighCutoff);
-    //invAP2.setCutoffFrequency(midHighCutoff);
+    // the gains ramp per sample towards a new value, so a change never steps the level
+    path.inputGain.setGainDecibels(inputGainParam->get());
+    path.outputGain.setGainDecibels(outputGainParam->get());
+}
 
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
+int SimpleMBCompAudioProcessor::getSamplesUntilFadeEnds() const {
+    auto remaining = bypassMix.getRemainingSamples();
+    for (size_t i = 0; i < bandGains.size(); ++i) {
+        // a band's fade only advances while the band runs
+        auto bandRemaining = bandIsActive[i] ? bandGains[i].getRemainingSamples() : 0;
+        if (bandRemaining > 0 && (remaining == 0 || bandRemaining < remaining)) {
+            remaining = bandRemaining;
+        }
+    }
+    return remaining;
+}
+
+void SimpleMBCompAudioProcessor::updateBandActivity() {
+    auto bandsAreSoloed = std::any_of(compressors.begin(), compressors.end(), [](const auto& comp) { return comp.solo->get(); });
+
+    for (size_t i = 0; i < compressors.size(); ++i) {
+        auto& comp = compressors[i];
+        auto audible = bandsAreSoloed ? comp.solo->get() : !comp.mute->get();
+        bandGains[i].setTargetValue(audible ? 1.f : 0.f);
+
+        // a band keeps running until it has completely faded out, or for as long as its own output is on
+        auto wasActive = bandIsActive[i];
+        bandIsActive[i] = audible || bandGains[i].getCurrentValue() > 0.f || bandOutputIsEnabled[i];
+
+        // Muted bands keep their filters warm so unmuting is seamless. A solo is usually held for a while,
+        // so the filters that only feed discarded bands are left idle and refreshed when they are needed again.
+        bandNeedsFilters[i] = bandIsActive[i] || !bandsAreSoloed;
+
+        if (bandIsActive[i] && !wasActive) {
+            resumeBand(i);
+        }
+    }
+}
+
+void SimpleMBCompAudioProcessor::resumeBand(size_t band) {
+    // whatever state this band was left with is stale, start it over from silence underneath the fade in
+    if (band < firstFusedBand) {
+        lowBandKernel.resetBand(0);
+        lowBandResampler.reset();
+    }
+    else {
+        compressorKernel.resetBand(static_cast<int>(band - firstFusedBand));
+        bandOversamplers[band].reset();
+        if (lowBandResampler.isActive()) {
+            forActivePath([this, band](auto& path) { path.multirateDelays[band - firstFusedBand].reset(); });
+        }
+    }
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::splitBands(std::array<juce::AudioBuffer<SampleType>, NUM_BANDS>& bands, bool useWorkers) {
+    auto& path = getPath<SampleType>();
+    auto numChannels = bands[0].getNumChannels();
+    auto numSamples = bands[0].getNumSamples();
+
+    // Each split leaves its low half where it was and writes its high half into the next band's buffer.
+    // Filters that only feed bands nobody will hear are skipped
+    if (crossoverMode == CrossoverMode::LinearPhase) {
+        // every channel goes through the same FFT scratch, so this one never shares out its channels
+        linearPhaseCrossover.process(bands, bandNeedsFilters);
+        return;
+    }
+    // and neither does the spectral engine, which links channels and compresses the bands as it splits them
+    if (crossoverMode == CrossoverMode::Spectral) {
+        spectralCompressor.process(bands, bandNeedsFilters);
+        return;
+    }
+
+    // the IIR crossovers keep separate state per channel, so the channels are shared out between the workers
+    std::array<SampleType* const*, NUM_BANDS> channels{};
+    for (size_t band = 0; band < bands.size(); ++band) {
+        channels[band] = bands[band].getArrayOfWritePointers();
+    }
+    auto isComplementary = crossoverMode == CrossoverMode::Complementary;
+    if (isComplementary) {
+        path.complementaryCrossover.prepareBlock(bandNeedsFilters);
+    }
+    else {
+        path.crossover.prepareBlock(bandNeedsFilters);
+    }
+
+    auto splitChannel = [&](int chan) {
+        if (isComplementary) {
+            path.complementaryCrossover.processChannel(channels, chan, numSamples);
+        }
+        else {
+            path.crossover.processChannel(channels, chan, numSamples);
+        }
+    };
+    if (useWorkers) {
+        forEachWorkItem(numChannels, numSamples, splitChannel);
+    }
+    else {
+        for (int chan = 0; chan < numChannels; ++chan) {
+            splitChannel(chan);
+        }
+    }
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::compressBands() {
+    // the spectral engine compressed the bands when it split them
+    if (crossoverMode == CrossoverMode::Spectral) {
+        return;
+    }
+
+    auto& path = getPath<SampleType>();
+    auto& filterBuffers = path.filterBuffers;
+    int numChannels = filterBuffers[0].getNumChannels();
+    int numSamples = filterBuffers[0].getNumSamples();
+
+    // hand every remaining band/channel pair to the kernel as one lane, so they are all compressed in a single pass.
+    // Bands that won't reach the output are left as null lanes and skipped
+    std::array<SampleType*, CompressorKernel::MaxLanes> lanes{};
+    auto anyLanes = false;
+    for (size_t band = firstFusedBand; band < filterBuffers.size(); ++band) {
+        if (!bandIsActive[band] || bandOversamplers[band].isActive()) {
+            continue;
+        }
+        anyLanes = true;
+        for (int chan = 0; chan < numChannels; ++chan) {
+            lanes[(band - firstFusedBand) * static_cast<size_t>(numChannels) + static_cast<size_t>(chan)] = filterBuffers[band].getWritePointer(chan);
+        }
+    }
+
+    // The decimated low band, the fused kernel and each oversampled band don't share any state, so they are separate
+    // work items. A job is a band index, or FusedJob for the fused kernel
+    constexpr size_t FusedJob = NUM_BANDS;
+    std::array<size_t, NUM_BANDS + 1> jobs{};
+    auto numJobs = 0;
+    if (lowBandResampler.isActive() && bandIsActive[0]) {
+        jobs[static_cast<size_t>(numJobs++)] = 0;
+    }
+    if (anyLanes) {
+        jobs[static_cast<size_t>(numJobs++)] = FusedJob;
+    }
+    for (size_t band = firstFusedBand; band < filterBuffers.size(); ++band) {
+        if (bandIsActive[band] && bandOversamplers[band].isActive()) {
+            jobs[static_cast<size_t>(numJobs++)] = band;
+        }
+    }
+
+    // the bands above the decimated one wait for its trip through the resampler
+    auto alignWithLowBand = [&](size_t band) {
+        if (lowBandResampler.isActive()) {
+            auto block = juce::dsp::AudioBlock<SampleType>(filterBuffers[band]);
+            auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
+            path.multirateDelays[band - firstFusedBand].process(ctx);
+        }
+    };
+
+    forEachWorkItem(numJobs, numSamples, [&](int item) {
+        auto job = jobs[static_cast<size_t>(item)];
+        if (job == FusedJob) {
+            compressorKernel.process(lanes.data(), numSamples);
+            for (size_t band = firstFusedBand; band < filterBuffers.size(); ++band) {
+                if (bandIsActive[band] && !bandOversamplers[band].isActive()) {
+                    alignWithLowBand(band);
+                }
+            }
+        }
+        else if (job < firstFusedBand) {
+            // The low band holds nothing above the low-mid crossover, so at high sample rates it is compressed at a fraction of the rate
+            auto& reduced = lowBandResampler.decimate(filterBuffers[0]);
+            if (reduced.getNumSamples() > 0) {
+                lowBandKernel.process(reduced.getArrayOfWritePointers(), reduced.getNumSamples());
+            }
+            lowBandResampler.interpolate(filterBuffers[0]);
+        }
+        else {
+            // the oversampled bands each go through their own kernel, at their own rate
+            bandOversamplers[job].process(filterBuffers[job]);
+            alignWithLowBand(job);
+        }
+    });
 }
 
-void SimpleMBCompAudioProcessor::splitBands(const juce::AudioBuffer<float>& inputBuffer) {
-    // this wasn't explained in the video at all, but this for loop is actually populating the filterBuffers with
-    // copies of the buffer using the reference to each buffer in the array with 'auto& fb'
-    // this allows all the code below to let the LinkwitzRileyFilter work on the buffer
-    // while leaving the signal intact when the filter outputs are summed.
-    for (auto& fb : filterBuffers) {
-        fb = inputBuffer;
+double SimpleMBCompAudioProcessor::calculateTailLengthSeconds() const {
+    // The crossover rings longest where its slowest pole is, usually at the lowest crossover unless a higher one is
+    // steeper. Each LR filter is a Butterworth filter run twice, the extra time constant covers the doubled poles'
+    // t * e^(-at) envelope
+    auto decayRate = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < crossoverFreqs.size(); ++i) {
+        decayRate = juce::jmin(decayRate, Filter::getSlowestDecayRate(getCrossoverSlope(i), crossoverFreqs[i]->get()));
+    }
+    auto decayTimeConstants = -static_cast<double>(SILENCE_THRESHOLD_DB) / 20.0 * std::log(10.0) + 1.0;
+    auto filterSettlingSeconds = decayTimeConstants / decayRate;
+
+    // the FIR kernels end abruptly, the last input sample has left them once the latency and the rest of the kernel pass
+    auto sampleRate = getSampleRate();
+    if (crossoverMode == CrossoverMode::LinearPhase && sampleRate > 0.0) {
+        using FIR = LinearPhaseCrossover<NUM_BANDS>;
+        filterSettlingSeconds = (FIR::getLatencySamples() + FIR::KernelLength / 2 + 1) / sampleRate;
+    }
+    // and the last frame an input sample fell in is overlap-added one latency after it
+    if (crossoverMode == CrossoverMode::Spectral && sampleRate > 0.0) {
+        filterSettlingSeconds = SpectralCompressor<NUM_BANDS>::getLatencySamples() / sampleRate;
     }
 
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+    // The output goes quiet with the filters, but the envelopes only return to rest after a full release,
+    // which is when skipping the compressors can no longer be told apart from running them
+    auto longestRelease = 0.f;
+    for (const auto& comp : compressors) {
+        longestRelease = juce::jmax(longestRelease, comp.release->get());
+    }
 
-    // Ctx = context
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+    // the resampler's impulse response is twice its latency long
+    auto resamplerSeconds = sampleRate > 0.0 ? 2.0 * lowBandResampler.getLatencySamples() / sampleRate : 0.0;
 
-    // all three buffers must be processed the same number of times
-    // so each context must be ran through 2 filters to prevent delay artifacts
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
+    // and the lookahead, oversampling and pipeline hold everything back a little longer still
+    auto bandDelaySeconds = sampleRate > 0.0 ? (bandDelaySamples + pipelineLatency) / sampleRate : 0.0;
 
-    HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1]; // copy the processed buffer into the third buffer, so each buffer is processed twice still
-    LP2.process(fb1Ctx);
-    HP2.process(fb2Ctx);
+    return filterSettlingSeconds + resamplerSeconds + bandDelaySeconds + longestRelease / 1000.0;
+}
+
+void SimpleMBCompAudioProcessor::updateLatency() {
+    // the spectral engine does without the resampler and the kernels' band delays
+    auto latency = pipelineLatency;
+    if (crossoverMode == CrossoverMode::Spectral) {
+        latency += SpectralCompressor<NUM_BANDS>::getLatencySamples();
+    }
+    else {
+        latency += lowBandResampler.getLatencySamples() + bandDelaySamples;
+    }
+    if (crossoverMode == CrossoverMode::LinearPhase) {
+        latency += LinearPhaseCrossover<NUM_BANDS>::getLatencySamples();
+    }
+    forActivePath([latency](auto& path) { path.bypassDelay.setDelay(static_cast<float>(latency)); });
+    setLatencySamples(latency);
+}
+
+int SimpleMBCompAudioProcessor::getMaxLookaheadSamples() const {
+    // a whole number of decimation periods, so the low band's kernel can be delayed by exactly as much
+    auto factor = lowBandResampler.getFactor();
+    auto samples = static_cast<int>(std::ceil(LOOKAHEAD_MAX_MS * getSampleRate() / 1000.0));
+    return (samples + factor - 1) / factor * factor;
+}
+
+int SimpleMBCompAudioProcessor::getMaxBandDelaySamples() const {
+    // every oversampler has the same choice of factors and filters, so any band's maximum is every band's
+    auto factor = lowBandResampler.getFactor();
+    auto oversamplingLatency = bandOversamplers[0].getMaxLatencySamples();
+    return getMaxLookaheadSamples() + (oversamplingLatency + factor - 1) / factor * factor;
+}
+
+std::pair<CompressorKernel*, int> SimpleMBCompAudioProcessor::getBandKernel(size_t band) {
+    if (band < firstFusedBand) {
+        return { &lowBandKernel, 0 };
+    }
+    if (bandOversamplers[band].isActive()) {
+        return { &bandOversamplers[band].getKernel(), 0 };
+    }
+    return { &compressorKernel, static_cast<int>(band - firstFusedBand) };
+}
+
+void SimpleMBCompAudioProcessor::updateOversampling() {
+    auto filter = static_cast<BandOversampler::FilterType>(oversamplingFilterParam->getIndex());
+    for (size_t band = 0; band < compressors.size(); ++band) {
+        // the decimated low band has no use for it
+        auto factor = band < firstFusedBand ? BandOversampler::Factor::x1
+                                            : static_cast<BandOversampler::Factor>(compressors[band].oversampling->getIndex());
+        bandOversamplers[band].setMode(factor, filter);
+    }
+}
+
+void SimpleMBCompAudioProcessor::updateChannelLinks(bool force) {
+    auto newChannelLink = static_cast<ChannelLayout::Link>(channelLinkParam->getIndex());
+    if (newChannelLink == channelLink && !force) {
+        return;
+    }
+
+    // the envelopes carry on from where they were, a newly linked channel simply starts following its group's
+    channelLink = newChannelLink;
+    const auto* groups = channelLayout.getLinkGroups(channelLink).data();
+    compressorKernel.setChannelLinks(groups);
+    lowBandKernel.setChannelLinks(groups);
+    spectralCompressor.setChannelLinks(groups);
+    for (auto& oversampler : bandOversamplers) {
+        oversampler.setChannelLinks(groups);
+    }
+}
+
+void SimpleMBCompAudioProcessor::updateBandDelays() {
+    auto factor = lowBandResampler.getFactor();
+    std::array<int, NUM_BANDS> bandLookahead{};
+    auto delay = 0;
+    for (size_t i = 0; i < compressors.size(); ++i) {
+        bandLookahead[i] = juce::roundToInt(compressors[i].lookahead->get() * getSampleRate() / 1000.0);
+        delay = juce::jmax(delay, bandLookahead[i] + bandOversamplers[i].getLatencySamples());
+    }
+    delay = juce::jmin((delay + factor - 1) / factor * factor, getMaxBandDelaySamples());
+
+    // A new delay jumps the audio's read point, like any change of latency it isn't seamless
+    if (delay != bandDelaySamples) {
+        bandDelaySamples = delay;
+        updateLatency();
+    }
+
+    // The bands with less lookahead than the longest one just run their detectors closer to the delayed audio.
+    // An oversampled band already comes back late by its oversampler's latency, and its kernel counts at the higher rate
+    compressorKernel.setLookaheadDelay(delay);
+    lowBandKernel.setLookaheadDelay(delay / factor);
+    for (size_t i = 0; i < compressors.size(); ++i) {
+        auto& oversampler = bandOversamplers[i];
+        if (i < firstFusedBand) {
+            lowBandKernel.setBandLookahead(0, bandLookahead[i] / factor);
+        }
+        else if (oversampler.isActive()) {
+            auto& kernel = oversampler.getKernel();
+            kernel.setLookaheadDelay((delay - oversampler.getLatencySamples()) * oversampler.getFactor());
+            kernel.setBandLookahead(0, bandLookahead[i] * oversampler.getFactor());
+        }
+        else {
+            compressorKernel.setBandLookahead(static_cast<int>(i - firstFusedBand), bandLookahead[i]);
+        }
+    }
+}
+
+void SimpleMBCompAudioProcessor::updateCrossoverMode() {
+    auto newCrossoverMode = getCrossoverModeParam();
+    if (newCrossoverMode == crossoverMode) {
+        return;
+    }
+
+    // The modes split the signal with different phase (and the linear phase one with a different latency), so a switch
+    // can't be made seamless. The incoming crossover sat idle and starts over from silence
+    crossoverMode = newCrossoverMode;
+    forActivePath([](auto& path) { path.resetCrossovers(); });
+    linearPhaseCrossover.reset();
+    spectralCompressor.reset();
+    updateLatency();
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::processBypassPath(juce::AudioBuffer<SampleType>& buffer) {
+    auto& path = getPath<SampleType>();
+    for (size_t i = 0; i < path.bypassAllpasses.size(); ++i) {
+        path.bypassAllpasses[i].setSlope(getCrossoverSlope(i));
+        path.bypassAllpasses[i].setCutoffFrequency(crossoverFreqs[i]->get());
+    }
+
+    // the bypass path sits idle while processing, so it is cleared before it is heard again
+    if (!bypassPathIsWarm) {
+        for (auto& allpass : path.bypassAllpasses) {
+            allpass.reset();
+        }
+        path.bypassDelay.reset();
+        bypassPathIsWarm = true;
+    }
+
+    auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+    auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
+    if (getLatencySamples() > 0) {
+        path.bypassDelay.process(ctx);
+    }
+    // the IIR modes' bands sum to the all passes, every other mode's to the input itself, so only the latency needs matching
+    if (crossoverMode != CrossoverMode::LinkwitzRiley && crossoverMode != CrossoverMode::Complementary) {
+        return;
+    }
+    for (auto& allpass : path.bypassAllpasses) {
+        allpass.allpass(buffer);
+    }
+}
+
+void SimpleMBCompAudioProcessor::resetMainPath() {
+    // nothing in the main path ran while bypassed, so it starts over from silence under the crossfade
+    forActivePath([](auto& path) {
+        path.resetCrossovers();
+        for (auto& delay : path.multirateDelays) {
+            delay.reset();
+        }
+        path.inputGain.reset();
+        path.outputGain.reset();
+        path.pipeline.reset();
+    });
+    linearPhaseCrossover.reset();
+    spectralCompressor.reset();
+    compressorKernel.reset();
+    lowBandKernel.reset();
+    for (auto& oversampler : bandOversamplers) {
+        oversampler.reset();
+    }
+    lowBandResampler.reset();
+    for (auto& bandGain : bandGains) {
+        bandGain.setCurrentAndTargetValue(bandGain.getTargetValue());
+    }
+    mainPathIsWarm = true;
+}
+
+void SimpleMBCompAudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processHostBlockBypassed(buffer);
+}
+
+void SimpleMBCompAudioProcessor::processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processHostBlockBypassed(buffer);
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::processHostBlockBypassed(juce::AudioBuffer<SampleType>& buffer) {
+    // only the phase matched path runs, the host has already decided there is nothing to crossfade
+    juce::ScopedNoDenormals noDenormals;
+    for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    // the band outputs stay silent, there are no bands
+    auto mainBus = getBusBuffer(buffer, false, 0);
+    leftChannelFifo.update(mainBus);
+    rightChannelFifo.update(mainBus);
+
+    // the latency is reported whether or not the host bypasses us
+    updateCrossoverMode();
+    updateOversampling();
+    updateBandDelays();
+    processBypassPath(mainBus);
+    mainPathIsWarm = false;
+
+    mainPathRan = false;
+    publishMeters();
+}
+
+juce::AudioProcessorParameter* SimpleMBCompAudioProcessor::getBypassParameter() const
+{
+    return globalBypass;
+}
+
+bool SimpleMBCompAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
 }
 
 void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    // sine wave to test the spectrum analyzer
+    if (false) {
+        buffer.clear();
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        osc.process(ctx);
+        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
+        //gain.setGainDecibels(-12);
+        gain.process(ctx);
+    }
+
+    processHostBlock(buffer);
+}
+
+void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processHostBlock(buffer);
+}
+
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::processHostBlock(juce::AudioBuffer<SampleType>& buffer) {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -288,84 +899,207 @@ void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    updateState();
+    // The engine runs on the main bus. The band outputs after it were cleared above, and are only written to while
+    // the main path runs
+    auto mainBus = getBusBuffer(buffer, false, 0);
+    leftChannelFifo.update(mainBus);
+    rightChannelFifo.update(mainBus);
+
+    bypassMix.setTargetValue(globalBypass->get() ? 1.f : 0.f);
+    updateCrossoverMode();
+    updateOversampling();
+    updateChannelLinks(false);
+    updateBandDelays();
+    auto tailSeconds = calculateTailLengthSeconds();
+    tailLengthSeconds.store(tailSeconds);
+    tailSamples = static_cast<int>(tailSeconds * getSampleRate());
+
+    compressorKernel.resetMeters();
+    lowBandKernel.resetMeters();
+    spectralCompressor.resetMeters();
+    mainPathRan = false;
+
+    // Whatever size the host sends, the engine only ever sees blocks of at most preparedSubBlockSize samples,
+    // so nothing sized in prepareToPlay can be outgrown here. An empty buffer simply skips the loop.
+    // The parameters are read again for every sub-block, so a change made from the editor mid block is picked up at
+    // the next sub-block rather than the next host block
+    auto numSamples = mainBus.getNumSamples();
+    auto& path = getPath<SampleType>();
+    for (auto start = 0; start < numSamples;) {
+        auto end = juce::jmin(start + preparedSubBlockSize, numSamples);
+        // The processor knows when its own fades finish. Ending the sub-block there starts the cheaper path that
+        // follows (the bypass path, or a faded out band skipping compression) on that sample instead of a sub-block late
+        auto fadeEnd = start + getSamplesUntilFadeEnds();
+        if (fadeEnd - start >= FADE_SPLIT_MIN_SUB_BLOCK_SIZE && end - fadeEnd >= FADE_SPLIT_MIN_SUB_BLOCK_SIZE) {
+            end = fadeEnd;
+        }
+        path.subBlock.setDataToReferTo(mainBus.getArrayOfWritePointers(), mainBus.getNumChannels(), start, end - start);
+        for (size_t band = 0; band < path.bandOutputs.size(); ++band) {
+            auto bus = getBusBuffer(buffer, false, static_cast<int>(band) + 1);
+            if (bandOutputIsEnabled[band] && bus.getNumChannels() > 0) {
+                path.bandOutputs[band].setDataToReferTo(bus.getArrayOfWritePointers(), bus.getNumChannels(), start, end - start);
+            }
+            else {
+                path.bandOutputs[band] = juce::AudioBuffer<SampleType>();
+            }
+        }
+        processSubBlock(path.subBlock);
+        start = end;
+    }
+
+    publishMeters();
+}
 
-    // sine wave to test the spectrum analyzer
-    if (false) {
+template<typename SampleType>
+void SimpleMBCompAudioProcessor::processSubBlock(juce::AudioBuffer<SampleType>& buffer) {
+    auto& path = getPath<SampleType>();
+    auto& bypassBuffer = path.bypassBuffer;
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = buffer.getNumChannels();
+
+    // Once the crossfade has finished a bypassed instance only runs the all passes
+    if (!bypassMix.isSmoothing() && bypassMix.getTargetValue() == 1.f) {
+        processBypassPath(buffer);
+        mainPathIsWarm = false;
+        return;
+    }
+
+    // Digital silence in: once the tail has died away nothing in the main path can make a sound until the input returns,
+    // so it is skipped and simply reset when the input comes back
+    auto silenceThreshold = juce::Decibels::decibelsToGain(SILENCE_THRESHOLD_DB);
+    if (buffer.getMagnitude(0, numSamples) <= silenceThreshold) {
+        silentSamples = juce::jmin(silentSamples + numSamples, tailSamples + 1);
+    }
+    else {
+        silentSamples = 0;
+    }
+
+    if (silentSamples > tailSamples && !bypassMix.isSmoothing()) {
         buffer.clear();
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        osc.process(ctx);
-        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
-        //gain.setGainDecibels(-12);
-        gain.process(ctx);
+        mainPathIsWarm = false;
+        return;
+    }
+
+    if (!mainPathIsWarm) {
+        resetMainPath();
     }
+    mainPathRan = true;
 
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    auto isCrossfading = bypassMix.isSmoothing();
+    if (isCrossfading) {
+        bypassBuffer.setSize(numChannels, numSamples, false, false, true);
+        for (auto i = 0; i < numChannels; ++i) {
+            bypassBuffer.copyFrom(i, 0, buffer, i, 0, numSamples);
+        }
+        processBypassPath(bypassBuffer);
+    }
+    else {
+        bypassPathIsWarm = false;
+    }
 
-    applyGain(buffer, inputGain);
+    updateState<SampleType>();
+    updateBandActivity();
 
-    // null test
-    //invAPBuffer = buffer;
+    applyGain(buffer, path.inputGain);
 
-    splitBands(buffer);
+    // The crossover works in place on the band buffers, so the input is copied into the first one to leave the signal
+    // intact. When pipelined, this sub-block is split on the pipeline thread while the one before it is compressed and
+    // summed, so the workers are left to the compression
+    auto& bandsToSplit = pipelineLatency > 0 ? path.splitBuffers : path.filterBuffers;
+    if (pipelineLatency > 0) {
+        path.pipeline.beginSubBlock(numSamples, path.filterBuffers, path.splitBuffers);
+    }
+    else {
+        path.bandArena.referTo(path.filterBuffers, 0, numSamples);
+    }
+    for (auto i = 0; i < numChannels; ++i) {
+        bandsToSplit[0].copyFrom(i, 0, buffer, i, 0, numSamples);
+    }
 
-    for (size_t i = 0; i < filterBuffers.size(); ++i) {
-        compressors[i].process(filterBuffers[i]);
+    auto split = [this, &bandsToSplit] {
+        splitBands(bandsToSplit, pipelineLatency == 0);
+        if (pipelineLatency > 0) {
+            // A band split nowhere is compressed a sub-block from now, when it may be heard again as it fades in
+            for (size_t band = 0; band < bandsToSplit.size(); ++band) {
+                if (!bandNeedsFilters[band]) {
+                    bandsToSplit[band].clear();
+                }
+            }
+        }
+    };
+    if (pipelineLatency > 0 && numSamples >= WORKER_POOL_MIN_BLOCK_SIZE) {
+        pipelineThread.launch(split);
+    }
+    else {
+        split();
     }
 
-    // null test using all pass
-    //auto invAPBlock = juce::dsp::AudioBlock<float>(invAPBuffer);
-    //auto invAPCtx = juce::dsp::ProcessContextReplacing<float>(invAPBlock);
-    //invAP1.process(invAPCtx);
-    //invAP2.process(invAPCtx);
+    compressBands<SampleType>();
 
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
+    // each band output gets its band as compressed, ahead of solo, mute and the output trim
+    for (size_t band = 0; band < path.bandOutputs.size(); ++band) {
+        auto& output = path.bandOutputs[band];
+        for (auto i = 0; i < output.getNumChannels(); ++i) {
+            output.copyFrom(i, 0, path.filterBuffers[band], i, 0, numSamples);
+        }
+    }
 
     buffer.clear();
 
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source) {
+    auto addFilterBand = [nc = numChannels, ns = numSamples, simdPath = getSimdPath()](auto& inputBuffer, const auto& source, auto& bandGain) {
+        // solo and mute fade the band in and out rather than switching it
+        auto startGain = bandGain.getCurrentValue();
+        bandGain.skip(ns);
+        auto endGain = bandGain.getCurrentValue();
         for (auto i = 0; i < nc; ++i) {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
+            SimdKernels::addWithRamp(simdPath, inputBuffer.getWritePointer(i), source.getReadPointer(i), ns, startGain, endGain);
         }
     };
 
-    auto bandsAreSoloed = false;
-    for (auto& comp : compressors) {
-        if (comp.solo->get()) {
-            bandsAreSoloed = true;
-            break;
+    for (size_t i = 0; i < compressors.size(); ++i) {
+        if (bandIsActive[i]) {
+            addFilterBand(buffer, path.filterBuffers[i], bandGains[i]);
         }
     }
 
-    if (bandsAreSoloed) {
-        for (size_t i = 0; i < compressors.size(); ++i) {
-            auto& comp = compressors[i];
-            if (comp.solo->get()) {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
+    applyGain(buffer, path.outputGain);
+
+    if (isCrossfading) {
+        auto startMix = bypassMix.getCurrentValue();
+        bypassMix.skip(numSamples);
+        auto endMix = bypassMix.getCurrentValue();
+        for (auto i = 0; i < numChannels; ++i) {
+            buffer.applyGainRamp(i, 0, numSamples, 1.f - startMix, 1.f - endMix);
+            buffer.addFromWithRamp(i, 0, bypassBuffer.getReadPointer(i), numSamples, startMix, endMix);
         }
-    }
-    else {
-        for (size_t i = 0; i < compressors.size(); ++i) {
-            auto& comp = compressors[i];
-            if (!comp.mute->get()) {
-                addFilterBand(buffer, filterBuffers[i]);
+        // the band outputs fade out with the processed signal, bypassed there are no bands
+        for (auto& output : path.bandOutputs) {
+            for (auto i = 0; i < output.getNumChannels(); ++i) {
+                output.applyGainRamp(i, 0, numSamples, 1.f - startMix, 1.f - endMix);
             }
         }
     }
 
-    // null test using all pass
-    //if (compressor.bypassed->get()) {
-    //    for (auto ch = 0; ch < numChannels; ++ch) {
-    //        juce::FloatVectorOperations::multiply(invAPBuffer.getWritePointer(ch), -1.f, numSamples);
-    //    }
-    //    addFilterBand(buffer, invAPBuffer);
-    //}
+    if (pipelineLatency > 0) {
+        pipelineThread.wait();
+        path.pipeline.endSubBlock(numSamples);
+    }
+}
 
-    applyGain(buffer, outputGain);
+void SimpleMBCompAudioProcessor::publishMeters() {
+    // the kernels meter while they compress, so publishing the levels costs nothing extra
+    for (size_t band = 0; band < compressors.size(); ++band) {
+        if (!mainPathRan || !bandIsActive[band]) {
+            compressors[band].updateMeters({});
+            continue;
+        }
+        if (crossoverMode == CrossoverMode::Spectral) {
+            compressors[band].updateMeters(spectralCompressor.getBandLevels(static_cast<int>(band)));
+            continue;
+        }
+        auto [kernel, index] = getBandKernel(band);
+        compressors[band].updateMeters(kernel->getBandLevels(index));
+    }
 }
 
 //==============================================================================
@@ -377,7 +1111,6 @@ bool SimpleMBCompAudioProcessor::hasEditor() const
 juce::AudioProcessorEditor* SimpleMBCompAudioProcessor::createEditor()
 {
     return new SimpleMBCompAudioProcessorEditor (*this);
-    //return new juce::GenericAudioProcessorEditor(*this);
 }
 
 //==============================================================================
@@ -406,41 +1139,64 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::
     layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::GainIn), params.at(Names::GainIn), gainRange, GAIN_DEFAULT));
     layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::GainOut), params.at(Names::GainOut), gainRange, GAIN_DEFAULT));
 
+    // grouped by parameter rather than by band, the order hosts have always seen them in
+    auto addBandParams = [&layout](BandParam param, auto makeParam) {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            auto name = getBandParamName(param, band);
+            layout.add(makeParam(name));
+        }
+    };
+
     auto thresholdRange = NormalisableRange<float>(THRESHOLD_MIN_VAL, THRESHOLD_MAX_VAL, DEFAULT_INTERVAL, DEFAULT_SKEW_FACTOR);
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::ThresholdLowBand), params.at(Names::ThresholdLowBand), thresholdRange, THRESHOLD_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::ThresholdMidBand), params.at(Names::ThresholdMidBand), thresholdRange, THRESHOLD_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::ThresholdHighBand), params.at(Names::ThresholdHighBand), thresholdRange, THRESHOLD_DEFAULT));
+    addBandParams(BandParam::Threshold, [&](const String& name) { return std::make_unique<AudioParameterFloat>(name, name, thresholdRange, THRESHOLD_DEFAULT); });
 
     auto attackReleaseRange = NormalisableRange<float>(ATTACK_RELEASE_MIN_VAL, ATTACK_RELEASE_MAX_VAL, DEFAULT_INTERVAL, DEFAULT_SKEW_FACTOR);
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::AttackLowBand), params.at(Names::AttackLowBand), attackReleaseRange, ATTACK_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::AttackMidBand), params.at(Names::AttackMidBand), attackReleaseRange, ATTACK_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::AttackHighBand), params.at(Names::AttackHighBand), attackReleaseRange, ATTACK_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::ReleaseLowBand), params.at(Names::ReleaseLowBand), attackReleaseRange, RELEASE_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::ReleaseMidBand), params.at(Names::ReleaseMidBand), attackReleaseRange, RELEASE_DEFAULT));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::ReleaseHighBand), params.at(Names::ReleaseHighBand), attackReleaseRange, RELEASE_DEFAULT));
+    addBandParams(BandParam::Attack, [&](const String& name) { return std::make_unique<AudioParameterFloat>(name, name, attackReleaseRange, ATTACK_DEFAULT); });
+    addBandParams(BandParam::Release, [&](const String& name) { return std::make_unique<AudioParameterFloat>(name, name, attackReleaseRange, RELEASE_DEFAULT); });
 
     juce::StringArray sa;
     for (auto choice : RATIO_CHOICES) {
         sa.add(juce::String(choice, 1));
     }
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::RatioLowBand), params.at(Names::RatioLowBand), sa, RATIO_DEFAULT));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::RatioMidBand), params.at(Names::RatioMidBand), sa, RATIO_DEFAULT));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::RatioHighBand), params.at(Names::RatioHighBand), sa, RATIO_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::BypassedLowBand), params.at(Names::BypassedLowBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::BypassedMidBand), params.at(Names::BypassedMidBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::BypassedHighBand), params.at(Names::BypassedHighBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::MuteLowBand), params.at(Names::MuteLowBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::MuteMidBand), params.at(Names::MuteMidBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::MuteHighBand), params.at(Names::MuteHighBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::SoloLowBand), params.at(Names::SoloLowBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::SoloMidBand), params.at(Names::SoloMidBand), APVTS_BOOL_DEFAULT));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::SoloHighBand), params.at(Names::SoloHighBand), APVTS_BOOL_DEFAULT));
-
-    auto lowMidRange = NormalisableRange<float>(LOW_MID_MIN_FREQ, LOW_MID_MAX_FREQ, DEFAULT_INTERVAL, DEFAULT_SKEW_FACTOR);
-    auto midHighRange = NormalisableRange<float>(MID_HIGH_MIN_FREQ, MID_HIGH_MAX_FREQ, DEFAULT_INTERVAL, DEFAULT_SKEW_FACTOR);
-
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::LowMidCrossoverFreq), params.at(Names::LowMidCrossoverFreq), lowMidRange, LOW_MID_CROSSOVER_DEFAULT_FREQUENCY));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::MidHighCrossoverFreq), params.at(Names::MidHighCrossoverFreq), midHighRange, MID_HIGH_CROSSOVER_DEFAULT_FREQUENCY));
+    addBandParams(BandParam::Ratio, [&](const String& name) { return std::make_unique<AudioParameterChoice>(name, name, sa, RATIO_DEFAULT); });
+
+    auto makeBool = [](const String& name) { return std::make_unique<AudioParameterBool>(name, name, APVTS_BOOL_DEFAULT); };
+    addBandParams(BandParam::Bypassed, makeBool);
+    addBandParams(BandParam::Mute, makeBool);
+    addBandParams(BandParam::Solo, makeBool);
+
+    for (int i = 0; i < NUM_BANDS - 1; ++i) {
+        auto name = getCrossoverParamName(i);
+        auto range = getCrossoverRange(i);
+        layout.add(std::make_unique<AudioParameterFloat>(name, name, NormalisableRange<float>(range.min, range.max, DEFAULT_INTERVAL, DEFAULT_SKEW_FACTOR), range.defaultValue));
+    }
+
+    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::GlobalBypass), params.at(Names::GlobalBypass), APVTS_BOOL_DEFAULT));
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::CrossoverMode), params.at(Names::CrossoverMode), CROSSOVER_MODE_CHOICES, CROSSOVER_MODE_DEFAULT));
+
+    for (int i = 0; i < NUM_BANDS - 1; ++i) {
+        auto name = getCrossoverSlopeParamName(i);
+        layout.add(std::make_unique<AudioParameterChoice>(name, name, CROSSOVER_SLOPE_CHOICES, CROSSOVER_SLOPE_DEFAULT));
+    }
+
+    auto lookaheadRange = NormalisableRange<float>(LOOKAHEAD_MIN_MS, LOOKAHEAD_MAX_MS, LOOKAHEAD_INTERVAL_MS, DEFAULT_SKEW_FACTOR);
+    addBandParams(BandParam::Lookahead, [&](const String& name) { return std::make_unique<AudioParameterFloat>(name, name, lookaheadRange, LOOKAHEAD_DEFAULT_MS); });
+
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        auto name = getBandParamName(BandParam::Oversampling, band);
+        auto defaultIndex = band == NUM_BANDS - 1 ? OVERSAMPLING_HIGH_BAND_DEFAULT : OVERSAMPLING_DEFAULT;
+        layout.add(std::make_unique<AudioParameterChoice>(name, name, OVERSAMPLING_CHOICES, defaultIndex));
+    }
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::OversamplingFilter), params.at(Names::OversamplingFilter), OVERSAMPLING_FILTER_CHOICES, OVERSAMPLING_FILTER_DEFAULT));
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::ChannelLink), params.at(Names::ChannelLink), CHANNEL_LINK_CHOICES, CHANNEL_LINK_DEFAULT));
+
+    juce::StringArray spectralBandChoices;
+    for (auto count : SPECTRAL_BAND_COUNTS) {
+        spectralBandChoices.add(juce::String(count));
+    }
+    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::SpectralBands), params.at(Names::SpectralBands), spectralBandChoices, SPECTRAL_BANDS_DEFAULT));
+    // appended last, parameters are identified by their index in some hosts so existing ones keep theirs
+    addBandParams(BandParam::ControlRate, [](const String& name) { return std::make_unique<AudioParameterChoice>(name, name, CONTROL_RATE_CHOICES, CONTROL_RATE_DEFAULT); });
 
     return layout;
 }
@@ -11,8 +11,26 @@
 #include <JuceHeader.h>
 #include <array>
 #include "Constants.h"
+#include "DSP/BackgroundBuilder.h"
+#include "DSP/BandOversampler.h"
+#include "DSP/BandArena.h"
+#include "DSP/BandPipeline.h"
+#include "DSP/ChannelLayout.h"
 #include "DSP/CompressorBand.h"
+#include "DSP/ComplementaryCrossover.h"
+#include "DSP/CrossoverTree.h"
+#include "DSP/LinearPhaseCrossover.h"
+#include "DSP/MultirateResampler.h"
+#include "DSP/PipelineThread.h"
+#include "DSP/SimdDispatch.h"
 #include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/SpectralCompressor.h"
+#include "DSP/WorkerPool.h"
+
+// the AudioBuffer::setDataToReferTo() overload with a start sample (BandArena, processBlock()) and
+// Thread::RealtimeOptions (WorkerPool, PipelineThread) arrived in JUCE 7.0.6
+static_assert(JUCE_MAJOR_VERSION > 7 || (JUCE_MAJOR_VERSION == 7 && (JUCE_MINOR_VERSION > 0 || JUCE_BUILDNUMBER >= 6)),
+              "SimpleMBComp needs JUCE 7.0.6 or later");
 
 //==============================================================================
 class SimpleMBCompAudioProcessor  : public juce::AudioProcessor
@@ -31,6 +49,14 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    // the whole signal path runs in double precision when the host asks for it, see SamplePath
+    bool supportsDoublePrecisionProcessing() const override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    juce::AudioProcessorParameter* getBypassParameter() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -64,43 +90,226 @@ public:
     SingleChannelSampleFifo<BlockType> leftChannelFifo{ Channel::Left };
     SingleChannelSampleFifo<BlockType> rightChannelFifo{ Channel::Right };
 
-    std::array<CompressorBand, 3> compressors;
-    CompressorBand& lowBandComp = compressors[0];
-    CompressorBand& midBandComp = compressors[1];
-    CompressorBand& highBandComp = compressors[2];
+    // Size of the blocks the engine runs on, whatever the host sends. Takes effect on the next prepareToPlay()
+    void setSubBlockSize(int numSamples);
+    // Threads helping the audio thread with the channels and kernels of each sub-block, at most WORKER_THREADS_MAX.
+    // WORKER_THREADS_AUTOMATIC only uses them for layouts wider than stereo. Takes effect on the next prepareToPlay()
+    void setNumWorkerThreads(int numThreads);
+    // Splits each sub-block into bands on a helper thread while the sub-block before it is compressed on the audio
+    // thread, for one sub-block of extra latency. Takes effect on the next prepareToPlay()
+    void setPipelined(bool shouldBePipelined);
+    // Forces the hot kernels onto one SimdPath, for testing. SimdPath::Automatic, the default, picks the fastest the CPU
+    // supports, and so does a path it doesn't. Takes effect on the next prepareToPlay()
+    void setSimdPath(SimdPath path);
+    // the path the kernels and the analyzer run on, for diagnostics. Safe to call from any thread
+    SimdPath getSimdPath() const { return activeSimdPath.load(std::memory_order_relaxed); }
+
+    // lowest band first
+    std::array<CompressorBand, NUM_BANDS> compressors;
+
+    enum class CrossoverMode {
+        LinkwitzRiley, // bands sum to an all pass, both skirts of every band as steep as the crossover's slope
+        Complementary, // the middle band is what the others leave of the same all pass, see ComplementaryCrossover
+        LinearPhase,   // bands sum to the input delayed, no phase shift anywhere at the cost of latency
+        Spectral       // bands cut from a short time spectrum and compressed in 16 to 64 narrower bands, see SpectralCompressor
+    };
 
 private:
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    // this is being formatted this way to show the three bands
-    // all filters induce a small delay, so we need the signal to travel through the same number of filters across all three bands
-    // LP1 goes through an all pass and makes the low band
-    // HP1 goes through another HP at a higher frequency for the high band, and goes through a LP for the mid band
-    //     fc0  fc1
-    Filter LP1, AP2,
-           HP1, LP2,
-                HP2;
-
-    // Null test all pass filter
-    //Filter invAP1, invAP2;
-    //juce::AudioBuffer<float> invAPBuffer;
-
-    juce::AudioParameterFloat* lowMidCrossover{ nullptr };
-    juce::AudioParameterFloat* midHighCrossover{ nullptr };
-    std::array < juce::AudioBuffer<float>, 3> filterBuffers;
-
-    juce::dsp::Gain<float> inputGain, outputGain;
+    using Filter = CrossoverFilter<float>;
+
+    // Everything that holds samples, once for each precision the host can process in. Only the path for the current
+    // precision is prepared and run, the detectors, gains and every other setting are shared by both.
+    // The FIR crossover, the low band resampler and the lookahead history stay single precision either way
+    template<typename SampleType>
+    struct SamplePath {
+        using Buffer = juce::AudioBuffer<SampleType>;
+        using Delay = juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None>;
+
+        // every band passes through every crossover once, either as part of its split or as an all pass, see CrossoverTree
+        CrossoverTree<SampleType, NUM_BANDS> crossover;
+        // derives the bands by subtraction instead, selected with the crossover mode parameter
+        ComplementaryCrossover<SampleType, NUM_BANDS> complementaryCrossover;
+
+        // The bands sum back to an all pass at each crossover, so the bypassed signal goes through the same all passes
+        // (and the same latency) to keep the phase response identical when the bypass is toggled
+        std::array<CrossoverFilter<SampleType>, NUM_BANDS - 1> bypassAllpasses;
+        Delay bypassDelay;
+        Buffer bypassBuffer;
+
+        Buffer subBlock; // refers into the host buffer, never owns any samples
+        // the same stretch of each band's output bus, no channels while the bus is off
+        std::array<Buffer, NUM_BANDS> bandOutputs;
+        // The bands being split, compressed and summed are views that never own samples. They refer into the arena, or
+        // into the pipeline when pipelined
+        BandArena<SampleType, NUM_BANDS> bandArena;
+        std::array<Buffer, NUM_BANDS> filterBuffers;
+        std::array<Buffer, NUM_BANDS> splitBuffers;
+        BandPipeline<SampleType, NUM_BANDS> pipeline;
+        juce::dsp::Gain<SampleType> inputGain, outputGain;
+
+        // the bands above the decimated low band wait for its trip through the resampler
+        std::array<Delay, NUM_BANDS - 1> multirateDelays;
+
+        // no pipeline when pipelineLatency is 0
+        void prepare(const juce::dsp::ProcessSpec& spec, int multirateLatency, int maxBypassDelay, int pipelineLatency);
+        // the crossovers are reset whenever they start running again
+        void resetCrossovers();
+    };
+
+    SamplePath<float> floatPath;
+    SamplePath<double> doublePath;
+
+    template<typename SampleType>
+    SamplePath<SampleType>& getPath();
+    // for the code that doesn't care about the precision, calls function with the path currently being processed
+    template<typename Function>
+    void forActivePath(Function&& function) {
+        if (isUsingDoublePrecision()) {
+            function(doublePath);
+        }
+        else {
+            function(floatPath);
+        }
+    }
+
+    juce::AudioParameterChoice* crossoverModeParam{ nullptr };
+    CrossoverMode crossoverMode{ CrossoverMode::LinkwitzRiley };
+    CrossoverMode getCrossoverModeParam() const { return static_cast<CrossoverMode>(crossoverModeParam->getIndex()); }
+    // follows the mode parameter, once per host block as it can change the latency
+    void updateCrossoverMode();
+
+    // FIR bands for mastering, also selected with the crossover mode parameter
+    LinearPhaseCrossover<NUM_BANDS> linearPhaseCrossover;
+    // Splits and compresses in one go when the crossover mode is Spectral, the kernels and the resampler sit idle.
+    // The spectral band count follows its parameter once per sub-block
+    SpectralCompressor<NUM_BANDS> spectralCompressor;
+    juce::AudioParameterChoice* spectralBandsParam{ nullptr };
+    int getNumSpectralBandsParam() const { return SPECTRAL_BAND_COUNTS[static_cast<size_t>(spectralBandsParam->getIndex())]; }
+    // redesigns its kernels off the audio thread. Runs between prepareToPlay() and releaseResources(), and is
+    // declared after everything its jobs touch so it is stopped before they go away
+    BackgroundBuilder builder;
+
+    // each crossover has its own slope, lowest crossover first
+    std::array<juce::AudioParameterChoice*, NUM_BANDS - 1> crossoverSlopes{};
+    CrossoverSlope getCrossoverSlope(size_t index) const { return static_cast<CrossoverSlope>(crossoverSlopes[index]->getIndex()); }
+
+    // A linear ramp that can say how far off its end is, so a sub-block can stop where a fade does
+    struct Fade : juce::SmoothedValue<float> {
+        int getRemainingSamples() const { return isSmoothing() ? countdown : 0; }
+    };
+    // samples until the next of the bypass crossfade and band fades ends, 0 if none is running
+    int getSamplesUntilFadeEnds() const;
+
+    juce::AudioParameterBool* globalBypass{ nullptr };
+    Fade bypassMix; // 0 processed, 1 bypassed
+    bool mainPathIsWarm{ true };
+    bool bypassPathIsWarm{ false };
+
+    // Once the input has been silent for longer than the tail, the main path is skipped and outputs zeros
+    int silentSamples{ 0 };
+    int tailSamples{ 0 };
+    // Reads the crossover mode, band delays and pipeline latency, which only the audio thread writes, so it is only
+    // called there. getTailLengthSeconds() returns what it last published
+    double calculateTailLengthSeconds() const;
+    std::atomic<double> tailLengthSeconds{ 0.0 };
+
+    int numWorkerThreads{ WORKER_THREADS_AUTOMATIC };
+    WorkerPool workerPool;
+    // runs job(item) for every item, shared with the workers unless the sub-block is too short to be worth it
+    template<typename Job>
+    void forEachWorkItem(int numItems, int numSamples, Job&& job) {
+        if (numSamples < WORKER_POOL_MIN_BLOCK_SIZE) {
+            for (int item = 0; item < numItems; ++item) {
+                job(item);
+            }
+            return;
+        }
+        workerPool.run(numItems, job);
+    }
+
+    // the split runs one sub-block ahead on the pipeline thread, see setPipelined()
+    bool shouldPipeline{ false };
+    int pipelineLatency{ 0 }; // 0 unless pipelined
+    PipelineThread pipelineThread;
+
+    SimdPath requestedSimdPath{ SimdPath::Automatic };
+    std::atomic<SimdPath> activeSimdPath{ SimdPath::Baseline };
+
+    int subBlockSize{ SUB_BLOCK_SIZE_DEFAULT };
+    int preparedSubBlockSize{ SUB_BLOCK_SIZE_DEFAULT };
+    bool mainPathRan{ false };
+
+    std::array<juce::AudioParameterFloat*, NUM_BANDS - 1> crossoverFreqs{}; // lowest crossover first
+
     juce::AudioParameterFloat* inputGainParam{ nullptr };
     juce::AudioParameterFloat* outputGainParam{ nullptr };
 
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain) {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+    template<typename SampleType, typename U>
+    void applyGain(juce::AudioBuffer<SampleType>& buffer, U& gain) {
+        auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
         gain.process(ctx);
     }
 
+    CompressorKernel compressorKernel;
+
+    // low band decimation, only active when the host rate is at least twice MULTIRATE_MIN_SAMPLE_RATE
+    MultirateResampler lowBandResampler;
+    CompressorKernel lowBandKernel;
+    size_t firstFusedBand{ 0 }; // bands below this are compressed by lowBandKernel instead of compressorKernel
+
+    // Each band can run its detector and gain stage oversampled on a kernel of its own
+    std::array<BandOversampler, NUM_BANDS> bandOversamplers;
+    juce::AudioParameterChoice* oversamplingFilterParam{ nullptr };
+    // the kernel compressing a band, and the band's index in it
+    std::pair<CompressorKernel*, int> getBandKernel(size_t band);
+    // follows the oversampling parameters once per host block, as they change the latency
+    void updateOversampling();
+
+    // Up to 7.1.4 on one instance, so surround stems share one crossover and can be linked across channels
+    ChannelLayout channelLayout;
+    juce::AudioParameterChoice* channelLinkParam{ nullptr };
+    ChannelLayout::Link channelLink{ ChannelLayout::Link::Independent };
+    // follows the channel link parameter once per host block, force applies it to freshly prepared kernels
+    void updateChannelLinks(bool force);
+
+    // Every band is delayed inside its kernel by the longest lookahead plus oversampling latency of any band, less its
+    // own oversampling latency, so the bands stay aligned and the latency is reported once.
+    // Follows the lookahead parameters once per host block
+    int bandDelaySamples{ 0 };
+    int getMaxLookaheadSamples() const;
+    int getMaxBandDelaySamples() const;
+    void updateBandDelays();
+
+    // Bands that are muted, or not soloed while another band is, skip compression once they have faded out
+    std::array<Fade, NUM_BANDS> bandGains;
+    std::array<bool, NUM_BANDS> bandIsActive{};
+    std::array<bool, NUM_BANDS> bandNeedsFilters{};
+    // the host has turned the band's own output bus on, see createBusesProperties()
+    std::array<bool, NUM_BANDS> bandOutputIsEnabled{};
+
+    // processBlock() and processBlockBypassed() for either precision
+    template<typename SampleType>
+    void processHostBlock(juce::AudioBuffer<SampleType>& buffer);
+    template<typename SampleType>
+    void processHostBlockBypassed(juce::AudioBuffer<SampleType>& buffer);
+
+    template<typename SampleType>
     void updateState();
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    void updateBandActivity();
+    void resumeBand(size_t band);
+    // bands[0] holds the input on entry. The workers only help when the pool isn't busy elsewhere
+    template<typename SampleType>
+    void splitBands(std::array<juce::AudioBuffer<SampleType>, NUM_BANDS>& bands, bool useWorkers);
+    template<typename SampleType>
+    void compressBands();
+    void updateLatency();
+    template<typename SampleType>
+    void processSubBlock(juce::AudioBuffer<SampleType>& buffer);
+    void publishMeters();
+    template<typename SampleType>
+    void processBypassPath(juce::AudioBuffer<SampleType>& buffer);
+    void resetMainPath();
 
     juce::dsp::Oscillator<float> osc;
     juce::dsp::Gain<float> gain;
@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    CompressorKernelTests.cpp
+    Created: 19 Oct 2026 2:22:00am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "TestUtilities.h"
+#include "../../Source/Constants.h"
+#include "../../Source/DSP/CompressorKernel.h"
+#include "../../Source/DSP/SimdDispatch.h"
+
+namespace {
+    struct BandSettings {
+        double sampleRate;
+        float attackMs;
+        float releaseMs;
+        float thresholdDb;
+        float ratio;
+    };
+
+    constexpr int TEST_BANDS = 3;
+    constexpr int TEST_CHANNELS = 2;
+    constexpr int TEST_LANES = TEST_BANDS * TEST_CHANNELS;
+
+    // host blocks of uneven sizes, so control intervals get cut short at block ends as well
+    const std::array<int, 5> BLOCK_SIZES{ 512, 333, 64, 1, 1000 };
+
+    // The bound documented on CompressorKernel::setBandControlRate(), for a lane peaking at peak
+    double getControlRateBound(const BandSettings& settings, int interval, CompressorKernel::GainInterpolation interpolation, double peak) {
+        auto coefficient = [&settings](double timeMs) {
+            return std::exp(-2.0 * juce::MathConstants<double>::pi * 1000.0 / settings.sampleRate / timeMs);
+        };
+        auto attackOverInterval = std::pow(coefficient(settings.attackMs), interval);
+        auto releaseOverInterval = std::pow(coefficient(settings.releaseMs), interval);
+        auto threshold = juce::Decibels::decibelsToGain(static_cast<double>(settings.thresholdDb));
+        auto slope = 1.0 - 1.0 / settings.ratio;
+
+        auto attackMovement = 1.0 - std::pow(attackOverInterval + (1.0 - attackOverInterval) * peak / threshold, -slope);
+        auto releaseMovement = 1.0 - std::pow(releaseOverInterval, slope);
+        auto bound = peak * juce::jmax(0.0, attackMovement, releaseMovement);
+        return interpolation == CompressorKernel::GainInterpolation::Cubic ? bound * 31.0 / 27.0 : bound;
+    }
+
+    // Every lane gets a different kind of material: tone bursts low and high, noise bursts at random levels,
+    // an amplitude modulated tone and decaying drum-like hits
+    std::array<std::vector<float>, TEST_LANES> makeTestSignals(double sampleRate, int numSamples) {
+        std::array<std::vector<float>, TEST_LANES> signals;
+        juce::Random random(2026);
+        const auto burstLength = static_cast<int>(sampleRate * 0.05);
+        const auto twoPi = juce::MathConstants<double>::twoPi;
+
+        for (int i = 0; i < TEST_LANES; ++i) {
+            signals[static_cast<size_t>(i)].assign(static_cast<size_t>(numSamples), 0.f);
+        }
+        auto burstLevel = 1.f;
+        for (int i = 0; i < numSamples; ++i) {
+            const auto t = static_cast<double>(i) / sampleRate;
+            const auto isBurst = (i / burstLength) % 2 == 0;
+            if (i % burstLength == 0) {
+                burstLevel = 0.05f + 0.95f * random.nextFloat();
+            }
+
+            signals[0][static_cast<size_t>(i)] = isBurst ? static_cast<float>(std::sin(twoPi * 1000.0 * t)) : 0.f;
+            signals[1][static_cast<size_t>(i)] = isBurst ? static_cast<float>(std::sin(twoPi * 100.0 * t)) : 0.f;
+            signals[2][static_cast<size_t>(i)] = burstLevel * (2.f * random.nextFloat() - 1.f);
+            signals[3][static_cast<size_t>(i)] = isBurst ? burstLevel * (2.f * random.nextFloat() - 1.f) : 0.f;
+            signals[4][static_cast<size_t>(i)] = static_cast<float>(0.5 * (1.0 + std::sin(twoPi * 3.0 * t)) * std::sin(twoPi * 440.0 * t));
+            const auto sinceHit = static_cast<double>(i % (burstLength / 3)) / sampleRate;
+            signals[5][static_cast<size_t>(i)] = static_cast<float>(std::exp(-sinceHit / 0.005) * std::sin(twoPi * 150.0 * sinceHit));
+        }
+        return signals;
+    }
+
+    // the test signals repeated across numChannels channels, lane = band * numChannels + channel
+    template<size_t NumLanes>
+    std::array<std::vector<float>, NumLanes> spreadTestSignals(const std::array<std::vector<float>, TEST_LANES>& signals) {
+        std::array<std::vector<float>, NumLanes> spread;
+        for (size_t lane = 0; lane < NumLanes; ++lane) {
+            spread[lane] = signals[lane % TEST_LANES];
+        }
+        return spread;
+    }
+
+    template<size_t NumLanes>
+    void processInBlocks(CompressorKernel& kernel, std::array<std::vector<float>, NumLanes>& signals) {
+        const auto numSamples = static_cast<int>(signals[0].size());
+        std::array<float*, NumLanes> lanes{};
+        size_t block = 0;
+        for (int start = 0; start < numSamples; ) {
+            const auto length = juce::jmin(BLOCK_SIZES[block++ % BLOCK_SIZES.size()], numSamples - start);
+            for (size_t lane = 0; lane < lanes.size(); ++lane) {
+                lanes[lane] = signals[lane].data() + start;
+            }
+            kernel.process(lanes.data(), length);
+            start += length;
+        }
+    }
+}
+
+//==============================================================================
+// Control rate gain against the gain computed every sample
+struct CompressorKernelControlRateTest : juce::UnitTest {
+    CompressorKernelControlRateTest() : juce::UnitTest("Compressor kernel control rate", TestUtilities::ACCURACY_CATEGORY) {}
+
+    void runTest() override {
+        const std::array<BandSettings, 3> allSettings{ {
+            { 44100.0, 10.f, 100.f, -20.f, 4.f },
+            { 48000.0, ATTACK_RELEASE_MIN_VAL, 50.f, -30.f, 10.f },
+            { 96000.0, ATTACK_DEFAULT, RELEASE_DEFAULT, -10.f, 2.f }
+        } };
+
+        for (const auto& settings : allSettings) {
+            const auto numSamples = static_cast<int>(settings.sampleRate);
+            const auto input = makeTestSignals(settings.sampleRate, numSamples);
+
+            auto everySample = input;
+            CompressorKernel reference;
+            prepare(reference, settings);
+            processInBlocks(reference, everySample);
+
+            for (auto interval : { 8, 16 }) {
+                for (auto interpolation : { CompressorKernel::GainInterpolation::Linear, CompressorKernel::GainInterpolation::Cubic }) {
+                    const auto isCubic = interpolation == CompressorKernel::GainInterpolation::Cubic;
+                    beginTest(juce::String(settings.sampleRate / 1000.0, 1) + " kHz, " + juce::String(settings.ratio, 0) + ":1 at "
+                              + juce::String(settings.thresholdDb, 0) + " dB, every " + juce::String(interval)
+                              + (isCubic ? " cubic" : " linear"));
+
+                    auto controlRate = input;
+                    CompressorKernel kernel;
+                    prepare(kernel, settings);
+                    for (int band = 0; band < TEST_BANDS; ++band) {
+                        kernel.setBandControlRate(band, interval, interpolation);
+                    }
+                    processInBlocks(kernel, controlRate);
+
+                    for (size_t lane = 0; lane < input.size(); ++lane) {
+                        auto peak = 0.0, worst = 0.0, sumSquares = 0.0;
+                        for (size_t i = 0; i < input[lane].size(); ++i) {
+                            peak = juce::jmax(peak, static_cast<double>(std::abs(input[lane][i])));
+                            const auto difference = static_cast<double>(std::abs(controlRate[lane][i] - everySample[lane][i]));
+                            worst = juce::jmax(worst, difference);
+                            sumSquares += difference * difference;
+                        }
+                        // the bound is for exact log2/exp2, FastMath's polynomials move the gain very slightly more
+                        const auto bound = getControlRateBound(settings, interval, interpolation, peak) + 1.0e-4 * peak;
+                        logMessage("  lane " + juce::String(static_cast<int>(lane)) + ": peak difference " + TestUtilities::toDecibelString(worst)
+                                   + ", RMS " + TestUtilities::toDecibelString(std::sqrt(sumSquares / static_cast<double>(numSamples)))
+                                   + ", bound " + TestUtilities::toDecibelString(bound));
+                        expectLessOrEqual(worst, bound);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static void prepare(CompressorKernel& kernel, const BandSettings& settings) {
+        kernel.prepare(settings.sampleRate, TEST_BANDS, TEST_CHANNELS, 0);
+        for (int band = 0; band < TEST_BANDS; ++band) {
+            kernel.setBandParameters(band, settings.attackMs, settings.releaseMs, settings.thresholdDb, settings.ratio, false);
+        }
+    }
+};
+
+static CompressorKernelControlRateTest compressorKernelControlRateTest;
+
+//==============================================================================
+// Bands at different rates in one kernel. Six channels spread the bands over three registers, so the per sample gain
+// computer skips some of them, and every lane has to come out as it does with all bands at its own rate
+struct CompressorKernelMixedRateTest : juce::UnitTest {
+    CompressorKernelMixedRateTest() : juce::UnitTest("Compressor kernel mixed rates", TestUtilities::ACCURACY_CATEGORY) {}
+
+    void runTest() override {
+        constexpr int interval = 16;
+        const BandSettings settings{ 48000.0, ATTACK_RELEASE_MIN_VAL, 50.f, -30.f, 10.f };
+        const auto input = spreadTestSignals<MIXED_LANES>(makeTestSignals(settings.sampleRate, static_cast<int>(settings.sampleRate)));
+
+        auto everySample = input;
+        process(everySample, settings, -1, interval);
+        auto controlRate = input;
+        process(controlRate, settings, TEST_BANDS, interval);
+
+        for (int everySampleBand = 0; everySampleBand < TEST_BANDS; ++everySampleBand) {
+            beginTest("band " + juce::String(everySampleBand) + " every sample, the others every " + juce::String(interval));
+            auto mixed = input;
+            process(mixed, settings, everySampleBand, interval);
+
+            auto worst = 0.0;
+            for (size_t lane = 0; lane < input.size(); ++lane) {
+                const auto& expected = static_cast<int>(lane) / MIXED_CHANNELS == everySampleBand ? everySample[lane] : controlRate[lane];
+                for (size_t i = 0; i < input[lane].size(); ++i) {
+                    worst = juce::jmax(worst, static_cast<double>(std::abs(mixed[lane][i] - expected[i])));
+                }
+            }
+            logMessage("  peak difference from the single rate runs " + TestUtilities::toDecibelString(worst));
+            expectLessThan(worst, 1.0e-6);
+        }
+    }
+
+private:
+    static constexpr int MIXED_CHANNELS = 6;
+    static constexpr size_t MIXED_LANES = TEST_BANDS * MIXED_CHANNELS;
+
+    // everySampleBand runs every sample and the rest every interval samples, -1 runs them all every sample and
+    // TEST_BANDS none
+    static void process(std::array<std::vector<float>, MIXED_LANES>& signals, const BandSettings& settings, int everySampleBand, int interval) {
+        CompressorKernel kernel;
+        kernel.prepare(settings.sampleRate, TEST_BANDS, MIXED_CHANNELS, 0);
+        for (int band = 0; band < TEST_BANDS; ++band) {
+            kernel.setBandParameters(band, settings.attackMs, settings.releaseMs, settings.thresholdDb, settings.ratio, false);
+            if (everySampleBand >= 0 && band != everySampleBand) {
+                kernel.setBandControlRate(band, interval, CompressorKernel::GainInterpolation::Linear);
+            }
+        }
+        processInBlocks(kernel, signals);
+    }
+};
+
+static CompressorKernelMixedRateTest compressorKernelMixedRateTest;
+
+//==============================================================================
+// Every SimdPath this CPU runs against the baseline. Each path is built in its own file, so this also catches a
+// file that was compiled without its instruction set's flags or left out of the build
+struct CompressorKernelSimdPathTest : juce::UnitTest {
+    CompressorKernelSimdPathTest() : juce::UnitTest("Compressor kernel SIMD paths", TestUtilities::ACCURACY_CATEGORY) {}
+
+    void runTest() override {
+        const BandSettings settings{ 48000.0, ATTACK_RELEASE_MIN_VAL, 50.f, -30.f, 10.f };
+        const auto input = makeTestSignals(settings.sampleRate, static_cast<int>(settings.sampleRate));
+        auto baseline = input;
+        process(baseline, settings, SimdPath::Baseline);
+
+        for (auto path : { SimdPath::Avx2, SimdPath::Avx512 }) {
+            beginTest(SimdDispatch::getName(path));
+            if (!SimdDispatch::isSupported(path)) {
+                logMessage("  not supported here, skipped");
+                continue;
+            }
+
+            auto output = input;
+            process(output, settings, path);
+            auto worst = 0.0;
+            for (size_t lane = 0; lane < input.size(); ++lane) {
+                for (size_t i = 0; i < input[lane].size(); ++i) {
+                    worst = juce::jmax(worst, static_cast<double>(std::abs(output[lane][i] - baseline[lane][i])));
+                }
+            }
+            // FMA contraction is the only difference allowed
+            logMessage("  peak difference from the baseline " + TestUtilities::toDecibelString(worst));
+            expectLessThan(worst, 1.0e-5);
+        }
+    }
+
+private:
+    static void process(std::array<std::vector<float>, TEST_LANES>& signals, const BandSettings& settings, SimdPath path) {
+        CompressorKernel kernel;
+        kernel.prepare(settings.sampleRate, TEST_BANDS, TEST_CHANNELS, 0);
+        kernel.setSimdPath(path);
+        for (int band = 0; band < TEST_BANDS; ++band) {
+            kernel.setBandParameters(band, settings.attackMs, settings.releaseMs, settings.thresholdDb, settings.ratio, false);
+        }
+        processInBlocks(kernel, signals);
+    }
+};
+
+static CompressorKernelSimdPathTest compressorKernelSimdPathTest;
+
+//==============================================================================
+// 5 bands of 7.1.4, the widest kernel, with one band every sample and the rest at a control rate. Only the register
+// holding that band pays for the per sample gain computer, so this lands between the two single rate runs
+struct CompressorKernelBenchmark : juce::UnitTest {
+    CompressorKernelBenchmark() : juce::UnitTest("Compressor kernel speed", TestUtilities::BENCHMARK_CATEGORY) {}
+
+    void runTest() override {
+        constexpr int numBands = 5;
+        constexpr int numSamples = 512;
+        constexpr int repeats = 2000;
+        constexpr size_t numLanes = static_cast<size_t>(numBands * MAX_CHANNELS);
+        const auto input = spreadTestSignals<numLanes>(makeTestSignals(48000.0, numSamples));
+
+        beginTest("5 bands, 12 channels");
+        for (int everySampleBands : { numBands, 1, 0 }) {
+            CompressorKernel kernel;
+            kernel.prepare(48000.0, numBands, MAX_CHANNELS, 0);
+            for (int band = 0; band < numBands; ++band) {
+                kernel.setBandParameters(band, ATTACK_DEFAULT, RELEASE_DEFAULT, -20.f, 4.f, false);
+                if (band >= everySampleBands) {
+                    kernel.setBandControlRate(band, 16, CompressorKernel::GainInterpolation::Linear);
+                }
+            }
+
+            auto signals = input;
+            std::array<float*, numLanes> lanes{};
+            for (size_t lane = 0; lane < numLanes; ++lane) {
+                lanes[lane] = signals[lane].data();
+            }
+            const auto microseconds = TestUtilities::timeMicroseconds(repeats, [&]() { kernel.process(lanes.data(), numSamples); });
+            logMessage("  " + juce::String(everySampleBands) + " of " + juce::String(numBands) + " bands every sample: "
+                       + juce::String(microseconds * 1000.0 / numSamples, 2) + " ns per sample");
+        }
+    }
+};
+
+static CompressorKernelBenchmark compressorKernelBenchmark;
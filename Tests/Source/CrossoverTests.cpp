@@ -0,0 +1,399 @@
+/*
+  ==============================================================================
+
+    CrossoverTests.cpp
+    Created: 19 Oct 2026 2:30:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <complex>
+#include "TestUtilities.h"
+#include "../../Source/DSP/ComplementaryCrossover.h"
+#include "../../Source/DSP/CrossoverTree.h"
+#include "../../Source/DSP/LinearPhaseCrossover.h"
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int RESPONSE_LENGTH = 1 << 16; // long enough for the lowest crossover's impulse response to die away
+
+    template<typename Crossover, int NumBands>
+    void prepareCrossover(Crossover& crossover, const std::array<float, NumBands - 1>& frequencies, int blockSize, int numChannels) {
+        crossover.prepare({ SAMPLE_RATE, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            crossover.setCutoffFrequency(static_cast<int>(i), frequencies[i]);
+        }
+    }
+
+    // every band's impulse response, in one block
+    template<typename Crossover, int NumBands>
+    std::array<juce::AudioBuffer<float>, NumBands> getImpulseResponses(const std::array<float, NumBands - 1>& frequencies) {
+        Crossover crossover;
+        prepareCrossover<Crossover, NumBands>(crossover, frequencies, RESPONSE_LENGTH, 1);
+
+        std::array<juce::AudioBuffer<float>, NumBands> bands;
+        for (auto& band : bands) {
+            band.setSize(1, RESPONSE_LENGTH);
+            band.clear();
+        }
+        bands[0].setSample(0, 0, 1.f);
+        std::array<bool, NumBands> bandNeeded;
+        bandNeeded.fill(true);
+        crossover.process(bands, bandNeeded);
+        return bands;
+    }
+
+    // frequency response of an impulse response at one frequency, with delaySamples of pure delay taken out
+    std::complex<double> getResponse(const juce::AudioBuffer<float>& impulseResponse, double frequency, int delaySamples = 0) {
+        std::complex<double> sum;
+        const auto* samples = impulseResponse.getReadPointer(0);
+        for (int i = 0; i < impulseResponse.getNumSamples(); ++i) {
+            sum += static_cast<double>(samples[i]) * std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency * (i - delaySamples) / SAMPLE_RATE);
+        }
+        return sum;
+    }
+
+    double getMagnitudeDb(const juce::AudioBuffer<float>& impulseResponse, double frequency) {
+        return 20.0 * std::log10(juce::jmax(std::abs(getResponse(impulseResponse, frequency)), 1.0e-12));
+    }
+
+    // the three band crossover points the isolation figures in ComplementaryCrossover.h are given for
+    const std::array<float, 2> DOCUMENTED_CROSSOVERS{ 400.f, 2000.f };
+    const std::array<float, 4> FIVE_BAND_CROSSOVERS{ 100.f, 400.f, 2000.f, 8000.f };
+}
+
+//==============================================================================
+// The complementary crossover against the Linkwitz-Riley tree it is meant to match
+struct ComplementaryCrossoverTest : juce::UnitTest {
+    ComplementaryCrossoverTest() : juce::UnitTest("Complementary crossover", TestUtilities::ACCURACY_CATEGORY) {}
+
+    void runTest() override {
+        beginTest("Two bands sum to the tree's all pass");
+        expectSumsToTree<2>({ 1000.f });
+        beginTest("Three bands sum to the tree's all pass");
+        expectSumsToTree<3>(DOCUMENTED_CROSSOVERS);
+        beginTest("Five bands sum to the tree's all pass");
+        expectSumsToTree<5>(FIVE_BAND_CROSSOVERS);
+
+        beginTest("Three bands are as isolated as their own Linkwitz-Riley filters");
+        expectLinkwitzRileyIsolation<3>(DOCUMENTED_CROSSOVERS);
+        const auto bands = getImpulseResponses<ComplementaryCrossover<float, 3>, 3>(DOCUMENTED_CROSSOVERS);
+        const auto tree = getImpulseResponses<CrossoverTree<float, 3>, 3>(DOCUMENTED_CROSSOVERS);
+        const auto midAt100 = getMagnitudeDb(bands[1], 100.0);
+        const auto highAt200 = getMagnitudeDb(bands[2], 200.0);
+        logMessage("  mid band at 100 Hz: " + juce::String(midAt100, 1) + " dB, Linkwitz-Riley tree " + juce::String(getMagnitudeDb(tree[1], 100.0), 1) + " dB");
+        logMessage("  high band at 200 Hz: " + juce::String(highAt200, 1) + " dB, Linkwitz-Riley tree " + juce::String(getMagnitudeDb(tree[2], 200.0), 1) + " dB");
+        expectLessThan(midAt100, -45.0, "mid band at 100 Hz");
+        expectLessThan(highAt200, -75.0, "high band at 200 Hz");
+
+        beginTest("Five bands are as isolated as their own Linkwitz-Riley filters");
+        expectLinkwitzRileyIsolation<5>(FIVE_BAND_CROSSOVERS);
+    }
+
+private:
+    // Noise in uneven blocks through both crossovers, the bands of each added back up must agree to within float rounding
+    template<int NumBands>
+    void expectSumsToTree(const std::array<float, NumBands - 1>& frequencies) {
+        constexpr int numChannels = 2, maxBlockSize = 512, numSamples = 48000;
+        using Complementary = ComplementaryCrossover<float, NumBands>;
+        using Tree = CrossoverTree<float, NumBands>;
+        Complementary complementary;
+        Tree tree;
+        prepareCrossover<Complementary, NumBands>(complementary, frequencies, maxBlockSize, numChannels);
+        prepareCrossover<Tree, NumBands>(tree, frequencies, maxBlockSize, numChannels);
+
+        std::array<juce::AudioBuffer<float>, NumBands> complementaryBands, treeBands;
+        std::array<bool, NumBands> bandNeeded;
+        bandNeeded.fill(true);
+        juce::Random random(36);
+
+        auto worst = 0.0;
+        for (int start = 0, block = 0; start < numSamples; ++block) {
+            const auto blockSize = juce::jmin(block % 2 == 0 ? maxBlockSize : 77, numSamples - start);
+            for (size_t band = 0; band < complementaryBands.size(); ++band) {
+                complementaryBands[band].setSize(numChannels, blockSize, false, false, true);
+                treeBands[band].setSize(numChannels, blockSize, false, false, true);
+            }
+            for (int chan = 0; chan < numChannels; ++chan) {
+                for (int i = 0; i < blockSize; ++i) {
+                    complementaryBands[0].setSample(chan, i, 2.f * random.nextFloat() - 1.f);
+                }
+                treeBands[0].copyFrom(chan, 0, complementaryBands[0], chan, 0, blockSize);
+            }
+
+            complementary.process(complementaryBands, bandNeeded);
+            tree.process(treeBands, bandNeeded);
+
+            for (int chan = 0; chan < numChannels; ++chan) {
+                for (int i = 0; i < blockSize; ++i) {
+                    auto difference = 0.0;
+                    for (size_t band = 0; band < complementaryBands.size(); ++band) {
+                        difference += static_cast<double>(complementaryBands[band].getSample(chan, i)) - treeBands[band].getSample(chan, i);
+                    }
+                    worst = juce::jmax(worst, std::abs(difference));
+                }
+            }
+            start += blockSize;
+        }
+        logMessage("  largest difference from the tree's sum: " + TestUtilities::toDecibelString(worst));
+        expectLessOrEqual(worst, 1.0e-5);
+    }
+
+    // Every band's magnitude, from an octave below the lowest crossover to an octave above the highest, against its own
+    // crossovers' LR4 low and high passes. Band k may pass HP(k - 1) * LP(k), and the derived band also the
+    // LP(k - 1) * HP(k) left over from the subtraction, which is far down on both skirts
+    template<int NumBands>
+    void expectLinkwitzRileyIsolation(const std::array<float, NumBands - 1>& frequencies) {
+        const auto bands = getImpulseResponses<ComplementaryCrossover<float, NumBands>, NumBands>(frequencies);
+        std::array<juce::AudioBuffer<float>, NumBands - 1> lowpasses, highpasses;
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            const auto split = getImpulseResponses<CrossoverTree<float, 2>, 2>({ frequencies[i] });
+            lowpasses[i] = split[0];
+            highpasses[i] = split[1];
+        }
+
+        auto worst = -1000.0;
+        for (size_t band = 0; band < bands.size(); ++band) {
+            for (auto frequency = frequencies.front() / 2.0; frequency <= frequencies.back() * 2.0; frequency *= std::pow(2.0, 1.0 / 3.0)) {
+                auto magnitude = [frequency](const juce::AudioBuffer<float>* response, double missing) {
+                    return response == nullptr ? missing : std::abs(getResponse(*response, frequency));
+                };
+                const auto* below = band > 0 ? &highpasses[band - 1] : nullptr;
+                const auto* belowLow = band > 0 ? &lowpasses[band - 1] : nullptr;
+                const auto* above = band + 1 < bands.size() ? &lowpasses[band] : nullptr;
+                const auto* aboveHigh = band + 1 < bands.size() ? &highpasses[band] : nullptr;
+                const auto bound = magnitude(below, 1.0) * magnitude(above, 1.0) + magnitude(belowLow, 0.0) * magnitude(aboveHigh, 0.0);
+                // below this the band is down in the float rounding of the filters
+                if (20.0 * std::log10(bound) < ROUNDING_FLOOR_DB) {
+                    continue;
+                }
+                worst = juce::jmax(worst, getMagnitudeDb(bands[band], frequency) - 20.0 * std::log10(bound));
+            }
+        }
+        logMessage("  most any band rises above its own filters: " + juce::String(worst, 3) + " dB");
+        expectLessOrEqual(worst, ISOLATION_TOLERANCE_DB);
+    }
+
+    static constexpr double ISOLATION_TOLERANCE_DB = 0.1;
+    static constexpr double ROUNDING_FLOOR_DB = -130.0;
+};
+
+static ComplementaryCrossoverTest complementaryCrossoverTest;
+
+//==============================================================================
+// The complementary crossover against the Linkwitz-Riley tree, for the same filter work
+struct ComplementaryCrossoverBenchmark : juce::UnitTest {
+    ComplementaryCrossoverBenchmark() : juce::UnitTest("Complementary crossover speed", TestUtilities::BENCHMARK_CATEGORY) {}
+
+    void runTest() override {
+        beginTest("Three bands");
+        compare<3>(DOCUMENTED_CROSSOVERS);
+        beginTest("Five bands");
+        compare<5>(FIVE_BAND_CROSSOVERS);
+    }
+
+private:
+    static constexpr int BLOCK_SIZE = 128;
+    static constexpr int NUM_CHANNELS = 2;
+    static constexpr int REPEATS = 20000;
+
+    template<typename Crossover, int NumBands>
+    static double timeNanosecondsPerSample(const std::array<float, NumBands - 1>& frequencies) {
+        Crossover crossover;
+        prepareCrossover<Crossover, NumBands>(crossover, frequencies, BLOCK_SIZE, NUM_CHANNELS);
+        std::array<juce::AudioBuffer<float>, NumBands> bands;
+        for (auto& band : bands) {
+            band.setSize(NUM_CHANNELS, BLOCK_SIZE);
+        }
+        std::array<bool, NumBands> bandNeeded;
+        bandNeeded.fill(true);
+
+        juce::AudioBuffer<float> noise(NUM_CHANNELS, BLOCK_SIZE);
+        juce::Random random(36);
+        for (int chan = 0; chan < NUM_CHANNELS; ++chan) {
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                noise.setSample(chan, i, 2.f * random.nextFloat() - 1.f);
+            }
+        }
+
+        auto microseconds = TestUtilities::timeMicroseconds(REPEATS, [&]() {
+            for (int chan = 0; chan < NUM_CHANNELS; ++chan) {
+                bands[0].copyFrom(chan, 0, noise, chan, 0, BLOCK_SIZE);
+            }
+            crossover.process(bands, bandNeeded);
+        });
+        return microseconds * 1000.0 / (BLOCK_SIZE * NUM_CHANNELS);
+    }
+
+    template<int NumBands>
+    void compare(const std::array<float, NumBands - 1>& frequencies) {
+        const auto tree = timeNanosecondsPerSample<CrossoverTree<float, NumBands>, NumBands>(frequencies);
+        const auto complementary = timeNanosecondsPerSample<ComplementaryCrossover<float, NumBands>, NumBands>(frequencies);
+        logMessage("  ns per sample and channel: Linkwitz-Riley tree " + juce::String(tree, 2) + ", complementary "
+                   + juce::String(complementary, 2) + " (x" + juce::String(tree / complementary, 2) + ")");
+    }
+};
+
+static ComplementaryCrossoverBenchmark complementaryCrossoverBenchmark;
+
+//==============================================================================
+struct LinearPhaseCrossoverTest : juce::UnitTest {
+    LinearPhaseCrossoverTest() : juce::UnitTest("Linear phase crossover", TestUtilities::ACCURACY_CATEGORY) {}
+
+    void runTest() override {
+        beginTest("Three bands");
+        expectDocumentedResponse<3>(DOCUMENTED_CROSSOVERS);
+        beginTest("Five bands");
+        expectDocumentedResponse<5>({ 100.f, 400.f, 2000.f, 8000.f });
+    }
+
+private:
+    // The impulse response is fed in through uneven blocks, so partitions get filled across block boundaries.
+    // The bands must sum to the input delayed by getLatencySamples(), and every band must be zero phase around that
+    // delay, with the Linkwitz-Riley magnitude of -6 dB at each of its crossovers
+    template<int NumBands>
+    void expectDocumentedResponse(const std::array<float, NumBands - 1>& frequencies) {
+        using Crossover = LinearPhaseCrossover<NumBands>;
+        constexpr int numSamples = 4 * (Crossover::KernelLength + 1);
+        constexpr int latency = Crossover::getLatencySamples();
+
+        // set before prepare(), which designs the first kernels, so no builder thread is needed
+        auto crossover = std::make_unique<Crossover>();
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            crossover->setCutoffFrequency(static_cast<int>(i), frequencies[i]);
+        }
+        crossover->prepare({ SAMPLE_RATE, 512, 1 });
+
+        std::array<juce::AudioBuffer<float>, NumBands> responses;
+        for (auto& response : responses) {
+            response.setSize(1, numSamples);
+        }
+        std::array<juce::AudioBuffer<float>, NumBands> bands;
+        std::array<bool, NumBands> bandNeeded;
+        bandNeeded.fill(true);
+        for (int start = 0, block = 0; start < numSamples; ++block) {
+            const auto blockSize = juce::jmin(block % 2 == 0 ? 512 : 100, numSamples - start);
+            for (auto& band : bands) {
+                band.setSize(1, blockSize, false, false, true);
+            }
+            bands[0].clear();
+            if (start == 0) {
+                bands[0].setSample(0, 0, 1.f);
+            }
+            crossover->process(bands, bandNeeded);
+            for (size_t band = 0; band < bands.size(); ++band) {
+                responses[band].copyFrom(0, start, bands[band], 0, 0, blockSize);
+            }
+            start += blockSize;
+        }
+
+        auto worst = 0.0;
+        for (int i = 0; i < numSamples; ++i) {
+            auto sum = 0.0;
+            for (const auto& response : responses) {
+                sum += static_cast<double>(response.getSample(0, i));
+            }
+            worst = juce::jmax(worst, std::abs(sum - (i == latency ? 1.0 : 0.0)));
+        }
+        logMessage("  largest difference of the summed bands from a delayed impulse: " + TestUtilities::toDecibelString(worst));
+        expectLessOrEqual(worst, 1.0e-5, "sum");
+
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            for (auto band : { i, i + 1 }) {
+                const auto response = getResponse(responses[band], frequencies[i], latency);
+                const auto magnitudeDb = 20.0 * std::log10(std::abs(response));
+                const auto label = "band " + juce::String(static_cast<int>(band)) + " at " + juce::String(frequencies[i], 0) + " Hz";
+                logMessage("  " + label + ": " + juce::String(magnitudeDb, 2) + " dB, " + juce::String(std::arg(response), 4) + " rad");
+                expectWithinAbsoluteError(magnitudeDb, -6.0, 0.2, label);
+                expectWithinAbsoluteError(std::arg(response), 0.0, 0.01, label + " phase");
+            }
+        }
+    }
+};
+
+static LinearPhaseCrossoverTest linearPhaseCrossoverTest;
+
+//==============================================================================
+// Partitioned overlap-save against convolving every band with its kernel directly
+struct LinearPhaseCrossoverBenchmark : juce::UnitTest {
+    LinearPhaseCrossoverBenchmark() : juce::UnitTest("Linear phase crossover speed", TestUtilities::BENCHMARK_CATEGORY) {}
+
+    void runTest() override {
+        beginTest("Three bands");
+        compare<3>(DOCUMENTED_CROSSOVERS);
+        beginTest("Five bands");
+        compare<5>(FIVE_BAND_CROSSOVERS);
+    }
+
+private:
+    static constexpr int BLOCK_SIZE = 128;
+    static constexpr int NUM_CHANNELS = 2;
+
+    template<int NumBands>
+    void compare(const std::array<float, NumBands - 1>& frequencies) {
+        using Crossover = LinearPhaseCrossover<NumBands>;
+        auto crossover = std::make_unique<Crossover>();
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            crossover->setCutoffFrequency(static_cast<int>(i), frequencies[i]);
+        }
+        crossover->prepare({ SAMPLE_RATE, static_cast<juce::uint32>(BLOCK_SIZE), static_cast<juce::uint32>(NUM_CHANNELS) });
+
+        juce::AudioBuffer<float> noise(NUM_CHANNELS, BLOCK_SIZE);
+        juce::Random random(38);
+        for (int chan = 0; chan < NUM_CHANNELS; ++chan) {
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                noise.setSample(chan, i, 2.f * random.nextFloat() - 1.f);
+            }
+        }
+
+        std::array<juce::AudioBuffer<float>, NumBands> bands;
+        for (auto& band : bands) {
+            band.setSize(NUM_CHANNELS, BLOCK_SIZE);
+        }
+        std::array<bool, NumBands> bandNeeded;
+        bandNeeded.fill(true);
+        auto partitioned = TestUtilities::timeMicroseconds(4000, [&]() {
+            for (int chan = 0; chan < NUM_CHANNELS; ++chan) {
+                bands[0].copyFrom(chan, 0, noise, chan, 0, BLOCK_SIZE);
+            }
+            crossover->process(bands, bandNeeded);
+        });
+
+        // direct form, every band's KernelLength taps dotted with the input history for every sample
+        constexpr int kernelLength = Crossover::KernelLength;
+        std::vector<std::vector<float>> kernels(static_cast<size_t>(NumBands), std::vector<float>(static_cast<size_t>(kernelLength)));
+        for (auto& kernel : kernels) {
+            for (auto& tap : kernel) {
+                tap = 0.001f * (2.f * random.nextFloat() - 1.f);
+            }
+        }
+        std::vector<std::vector<float>> histories(static_cast<size_t>(NUM_CHANNELS), std::vector<float>(static_cast<size_t>(2 * kernelLength)));
+        int writePosition = 0;
+        auto direct = TestUtilities::timeMicroseconds(100, [&]() {
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                for (int chan = 0; chan < NUM_CHANNELS; ++chan) {
+                    // written twice, so the newest kernelLength samples are always contiguous
+                    auto& history = histories[static_cast<size_t>(chan)];
+                    history[static_cast<size_t>(writePosition)] = history[static_cast<size_t>(writePosition + kernelLength)] = noise.getSample(chan, i);
+                    for (size_t band = 0; band < kernels.size(); ++band) {
+                        const auto* samples = history.data() + writePosition + 1;
+                        auto sum = 0.f;
+                        for (int tap = 0; tap < kernelLength; ++tap) {
+                            sum += samples[tap] * kernels[band][static_cast<size_t>(tap)];
+                        }
+                        bands[band].setSample(chan, i, sum);
+                    }
+                }
+                writePosition = (writePosition + 1) % kernelLength;
+            }
+        });
+
+        const auto toNanoseconds = [](double microseconds) { return microseconds * 1000.0 / (BLOCK_SIZE * NUM_CHANNELS); };
+        logMessage("  ns per sample and channel: partitioned " + juce::String(toNanoseconds(partitioned), 1) + ", direct "
+                   + juce::String(toNanoseconds(direct), 1) + " (" + juce::String(direct / partitioned, 0) + "x)");
+    }
+};
+
+static LinearPhaseCrossoverBenchmark linearPhaseCrossoverBenchmark;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    DoublePrecisionTests.cpp
+    Created: 19 Oct 2026 2:33:40am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "TestUtilities.h"
+#include "../../Source/Constants.h"
+#include "../../Source/DSP/CompressorKernel.h"
+#include "../../Source/DSP/CrossoverTree.h"
+
+namespace {
+    constexpr int PATH_BANDS = 3;
+    constexpr int PATH_CHANNELS = 2;
+    constexpr int PATH_BLOCK_SIZE = 512;
+
+    // The crossover and the compressor kernel, the parts of the signal path instantiated for both precisions
+    template<typename SampleType>
+    struct SignalPath {
+        SignalPath(double sampleRate, float lowCrossover) {
+            crossover.prepare({ sampleRate, static_cast<juce::uint32>(PATH_BLOCK_SIZE), static_cast<juce::uint32>(PATH_CHANNELS) });
+            crossover.setCutoffFrequency(0, static_cast<SampleType>(lowCrossover));
+            crossover.setCutoffFrequency(1, static_cast<SampleType>(2000));
+
+            kernel.prepare(sampleRate, PATH_BANDS, PATH_CHANNELS, 0);
+            for (int band = 0; band < PATH_BANDS; ++band) {
+                kernel.setBandParameters(band, ATTACK_RELEASE_MIN_VAL, 100.f, -30.f, 4.f, false);
+            }
+            for (auto& band : bands) {
+                band.setSize(PATH_CHANNELS, PATH_BLOCK_SIZE);
+            }
+            bandNeeded.fill(true);
+        }
+
+        // returns the time spent splitting and compressing, in seconds
+        double process(const std::vector<double>& input) {
+            for (int chan = 0; chan < PATH_CHANNELS; ++chan) {
+                for (int i = 0; i < PATH_BLOCK_SIZE; ++i) {
+                    bands[0].setSample(chan, i, static_cast<SampleType>(input[static_cast<size_t>(i)]));
+                }
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            crossover.process(bands, bandNeeded);
+            std::array<SampleType*, PATH_BANDS * PATH_CHANNELS> lanes{};
+            for (int band = 0; band < PATH_BANDS; ++band) {
+                for (int chan = 0; chan < PATH_CHANNELS; ++chan) {
+                    lanes[static_cast<size_t>(band * PATH_CHANNELS + chan)] = bands[static_cast<size_t>(band)].getWritePointer(chan);
+                }
+            }
+            kernel.process(lanes.data(), PATH_BLOCK_SIZE);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count();
+        }
+
+        CrossoverTree<SampleType, PATH_BANDS> crossover;
+        CompressorKernel kernel;
+        std::array<juce::AudioBuffer<SampleType>, PATH_BANDS> bands;
+        std::array<bool, PATH_BANDS> bandNeeded;
+    };
+}
+
+//==============================================================================
+// Float against double through the same path, with a low crossover at high sample rates where float state
+// loses the most. Logs the CPU each takes and how far the float low band strays from the double one
+struct DoublePrecisionBenchmark : juce::UnitTest {
+    DoublePrecisionBenchmark() : juce::UnitTest("Float and double precision", TestUtilities::BENCHMARK_CATEGORY) {}
+
+    void runTest() override {
+        constexpr int numBlocks = 3000;
+        for (auto sampleRate : { 48000.0, 192000.0 }) {
+            for (auto lowCrossover : { 30.f, 200.f }) {
+                beginTest(juce::String(sampleRate / 1000.0, 0) + " kHz, low crossover at " + juce::String(lowCrossover, 0) + " Hz");
+                SignalPath<float> floatPath(sampleRate, lowCrossover);
+                SignalPath<double> doublePath(sampleRate, lowCrossover);
+                juce::Random random(42);
+
+                std::vector<double> input(static_cast<size_t>(PATH_BLOCK_SIZE));
+                auto floatSeconds = 0.0, doubleSeconds = 0.0, signalPower = 0.0, errorPower = 0.0;
+                for (int block = 0; block < numBlocks; ++block) {
+                    // a 40 Hz tone under a little noise, mostly landing in the low band
+                    for (int i = 0; i < PATH_BLOCK_SIZE; ++i) {
+                        const auto t = static_cast<double>(block * PATH_BLOCK_SIZE + i) / sampleRate;
+                        input[static_cast<size_t>(i)] = 0.5 * std::sin(juce::MathConstants<double>::twoPi * 40.0 * t) + 0.05 * (random.nextDouble() - 0.5);
+                    }
+                    floatSeconds += floatPath.process(input);
+                    doubleSeconds += doublePath.process(input);
+
+                    for (int i = 0; i < PATH_BLOCK_SIZE; ++i) {
+                        const auto reference = doublePath.bands[0].getSample(0, i);
+                        const auto error = reference - static_cast<double>(floatPath.bands[0].getSample(0, i));
+                        signalPower += reference * reference;
+                        errorPower += error * error;
+                    }
+                }
+
+                const auto realtimeSeconds = numBlocks * static_cast<double>(PATH_BLOCK_SIZE) / sampleRate;
+                logMessage("  float " + juce::String(100.0 * floatSeconds / realtimeSeconds, 3) + "% of realtime, double "
+                           + juce::String(100.0 * doubleSeconds / realtimeSeconds, 3) + "% (x" + juce::String(doubleSeconds / floatSeconds, 2) + ")");
+                logMessage("  float low band error relative to double: " + juce::String(10.0 * std::log10(errorPower / signalPower), 1) + " dB");
+            }
+        }
+    }
+};
+
+static DoublePrecisionBenchmark doublePrecisionBenchmark;
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    FastMathTests.cpp
+    Created: 19 Oct 2026 2:36:19am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "TestUtilities.h"
+#include "../../Source/DSP/FastMath.h"
+
+namespace {
+    // every 97th bit pattern of the normal positive floats, 22 million values with every exponent and a spread of mantissas
+    template<typename Function>
+    void forSpreadOfNormalFloats(Function&& function) {
+        constexpr std::uint32_t smallestNormal = 0x00800000u, infinity = 0x7f800000u, step = 97u;
+        for (auto bits = smallestNormal; bits < infinity; bits += step) {
+            float x;
+            std::memcpy(&x, &bits, sizeof(x));
+            function(x);
+        }
+    }
+}
+
+//==============================================================================
+// The error bounds documented at the top of FastMath.h, against double precision std:: maths
+struct FastMathAccuracyTest : juce::UnitTest {
+    FastMathAccuracyTest() : juce::UnitTest("FastMath error bounds", TestUtilities::ACCURACY_CATEGORY) {}
+
+    void runTest() override {
+        beginTest("log2");
+        auto worst = 0.0;
+        forSpreadOfNormalFloats([&worst](float x) {
+            worst = juce::jmax(worst, std::abs(static_cast<double>(FastMath::log2(x)) - std::log2(static_cast<double>(x))));
+        });
+        expectBelow(worst, 1.2e-5, "absolute");
+
+        beginTest("exp2");
+        worst = 0.0;
+        for (auto x = -126.0; x <= 126.0; x += 1.0e-4) {
+            const auto input = static_cast<float>(x);
+            worst = juce::jmax(worst, std::abs(FastMath::exp2(input) / std::exp2(static_cast<double>(input)) - 1.0));
+        }
+        expectBelow(worst, 2.5e-7, "relative");
+
+        beginTest("gainToDecibels and gainsToDecibels");
+        worst = 0.0;
+        auto batchMismatches = 0;
+        forSpreadOfNormalFloats([&worst, &batchMismatches](float gain) {
+            const auto reference = juce::jmax(-100.0, 20.0 * std::log10(static_cast<double>(gain)));
+            const auto decibels = FastMath::gainToDecibels(gain);
+            worst = juce::jmax(worst, std::abs(static_cast<double>(decibels) - reference));
+
+            float batched;
+            FastMath::gainsToDecibels(&gain, &batched, 1);
+            batchMismatches += batched == decibels ? 0 : 1;
+        });
+        expectBelow(worst, 1.1e-4, "absolute dB");
+        expectEquals(batchMismatches, 0, "gainsToDecibels differs from gainToDecibels");
+
+        beginTest("decibelsToGain");
+        worst = 0.0;
+        for (auto decibels = -99.99; decibels < 40.0; decibels += 1.0e-3) {
+            const auto input = static_cast<float>(decibels);
+            worst = juce::jmax(worst, std::abs(FastMath::decibelsToGain(input) / std::pow(10.0, static_cast<double>(input) / 20.0) - 1.0));
+        }
+        expectBelow(worst, 1.0e-6, "relative");
+        expectEquals(FastMath::decibelsToGain(-100.f), 0.f, "at minus infinity");
+
+        beginTest("LogFrequencyMapper");
+        worst = 0.0;
+        const FastMath::LogFrequencyMapper mapper(20.f, 20000.f);
+        for (auto frequency = 20.0; frequency <= 20000.0; frequency += 0.01) {
+            const auto input = static_cast<float>(frequency);
+            worst = juce::jmax(worst, std::abs(static_cast<double>(mapper(input)) - std::log10(static_cast<double>(input) / 20.0) / 3.0));
+        }
+        expectBelow(worst, 1.0e-6, "absolute");
+    }
+
+private:
+    void expectBelow(double worst, double bound, const juce::String& kind) {
+        logMessage("  worst " + kind + " error " + juce::String(worst, 12) + ", bound " + juce::String(bound, 12));
+        expectLessThan(worst, bound, kind);
+    }
+};
+
+static FastMathAccuracyTest fastMathAccuracyTest;
+
+//==============================================================================
+// FastMath against what it replaced, over arrays the size of the analyzer's spectrum
+struct FastMathBenchmark : juce::UnitTest {
+    FastMathBenchmark() : juce::UnitTest("FastMath speed", TestUtilities::BENCHMARK_CATEGORY) {}
+
+    void runTest() override {
+        constexpr int numValues = 4096; // the bins of the analyzer's order8192 FFT
+        constexpr int repeats = 20000;
+        juce::Random random(46);
+        std::vector<float> gains(numValues), frequencies(numValues), output(numValues);
+        for (int i = 0; i < numValues; ++i) {
+            gains[static_cast<size_t>(i)] = random.nextFloat();
+            frequencies[static_cast<size_t>(i)] = static_cast<float>(i + 1) * 5.86f;
+        }
+
+        beginTest("Decibels");
+        compare("juce::Decibels::gainToDecibels", "FastMath::gainsToDecibels", repeats, output, [&]() {
+            for (int i = 0; i < numValues; ++i) {
+                output[static_cast<size_t>(i)] = juce::Decibels::gainToDecibels(gains[static_cast<size_t>(i)], NEGATIVE_INFINITY_DB);
+            }
+        }, [&]() {
+            FastMath::gainsToDecibels(gains.data(), output.data(), numValues, NEGATIVE_INFINITY_DB);
+        });
+
+        beginTest("Log frequency positions");
+        const FastMath::LogFrequencyMapper mapper(20.f, 20000.f);
+        compare("juce::mapFromLog10", "FastMath::LogFrequencyMapper", repeats, output, [&]() {
+            for (int i = 0; i < numValues; ++i) {
+                output[static_cast<size_t>(i)] = juce::mapFromLog10(frequencies[static_cast<size_t>(i)], 20.f, 20000.f);
+            }
+        }, [&]() {
+            mapper.map(frequencies.data(), output.data(), numValues);
+        });
+
+        beginTest("Compressor gain computer");
+        // the log2 domain gain computer CompressorKernel runs on every lane, 4:1 over a -18 dB threshold
+        const auto thresholdLog2 = -3.f, slope = -0.75f;
+        compare("std::log2/std::exp2", "FastMath::log2/exp2", repeats, output, [&]() {
+            for (int i = 0; i < numValues; ++i) {
+                const auto over = std::log2(juce::jmax(gains[static_cast<size_t>(i)], 1.0e-10f)) - thresholdLog2;
+                output[static_cast<size_t>(i)] = juce::jmin(1.f, std::exp2(over * slope));
+            }
+        }, [&]() {
+            for (int i = 0; i < numValues; ++i) {
+                const auto over = FastMath::log2(FastMath::atLeast(gains[static_cast<size_t>(i)], 1.0e-10f)) - thresholdLog2;
+                output[static_cast<size_t>(i)] = juce::jmin(1.f, FastMath::exp2(over * slope));
+            }
+        });
+    }
+
+private:
+    static constexpr float NEGATIVE_INFINITY_DB = -48.f;
+
+    // output is read after every call, so neither loop can be optimised away
+    template<typename Reference, typename Fast>
+    void compare(const juce::String& referenceName, const juce::String& fastName, int repeats, std::vector<float>& output,
+                 Reference&& reference, Fast&& fast) {
+        volatile float sink = 0.f;
+        const auto referenceTime = TestUtilities::timeMicroseconds(repeats, [&]() { reference(); sink = sink + output.back(); });
+        const auto fastTime = TestUtilities::timeMicroseconds(repeats, [&]() { fast(); sink = sink + output.back(); });
+        logMessage("  " + referenceName + " " + juce::String(referenceTime, 2) + " us, " + fastName + " " + juce::String(fastTime, 2)
+                   + " us (x" + juce::String(referenceTime / fastTime, 1) + ")");
+    }
+};
+
+static FastMathBenchmark fastMathBenchmark;
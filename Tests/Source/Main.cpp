@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "TestUtilities.h"
+
+//==============================================================================
+// Runs every accuracy test, and the benchmarks too when --benchmarks is passed.
+// Returns non-zero when any test failed
+int main (int argc, char* argv[])
+{
+    auto runBenchmarks = false;
+    for (int i = 1; i < argc; ++i) {
+        runBenchmarks = runBenchmarks || juce::String(argv[i]) == "--benchmarks";
+    }
+
+    auto tests = juce::UnitTest::getTestsInCategory(TestUtilities::ACCURACY_CATEGORY);
+    if (runBenchmarks) {
+        tests.addArray(juce::UnitTest::getTestsInCategory(TestUtilities::BENCHMARK_CATEGORY));
+    }
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTests(tests);
+
+    auto failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i) {
+        failures += runner.getResult(i)->failures;
+    }
+    return failures > 0 ? 1 : 0;
+}
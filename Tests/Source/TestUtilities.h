@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    TestUtilities.h
+    Created: 19 Oct 2026 2:22:00am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <chrono>
+
+//==============================================================================
+namespace TestUtilities {
+    // Accuracy tests check documented bounds and fail the run when one is broken. Benchmarks only log timings,
+    // they run when asked for with --benchmarks
+    const juce::String ACCURACY_CATEGORY = "Accuracy";
+    const juce::String BENCHMARK_CATEGORY = "Benchmarks";
+
+    inline juce::String toDecibelString(double gain) {
+        return juce::String(20.0 * std::log10(juce::jmax(gain, 1.0e-12)), 1) + " dB";
+    }
+
+    // mean wall clock time of one call, in microseconds. One untimed call first, so nothing is timed cold
+    template<typename Function>
+    double timeMicroseconds(int repeats, Function&& function) {
+        function();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            function();
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / repeats;
+    }
+}